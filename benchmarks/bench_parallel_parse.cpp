@@ -0,0 +1,79 @@
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "../include/siddiqsoft/parallel_parse.hpp"
+#include "corpus.hpp"
+
+
+namespace siddiqsoft::bench
+{
+    /// @brief An 8 MB "key=value&..." batch file (keys repeat so the map stays small relative to the input).
+    const std::string& batch_records()
+    {
+        static const std::string text = [] {
+            lcg         rng;
+            std::string all;
+            while (all.size() < 8 * 1024 * 1024)
+                all += "k" + std::to_string(rng.next(4096)) + "=" + random_token(rng, 4, 48) + "&";
+            return all;
+        }();
+        return text;
+    }
+
+    /// @brief The same records as whitespace/comma separated words for the splitter.
+    const std::string& batch_words()
+    {
+        static const std::string text = [] {
+            std::string all = batch_records();
+            for (auto& c : all)
+                c = (c == '&') ? ' ' : (c == '=') ? ',' : c;
+            return all;
+        }();
+        return text;
+    }
+
+    /// @brief Throughput of parse_parallel with state.range(0) threads (1 is the serial parse).
+    void map_scaling(benchmark::State& state)
+    {
+        const auto&                   src = batch_records();
+        const parallel_parse::options options {static_cast<unsigned>(state.range(0)), 256 * 1024};
+        for (auto _ : state)
+        {
+            auto result = string2map::parse_parallel<std::string, std::string, std::multimap<std::string, std::string>>(
+                    src, "=", "&", "", options);
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+    }
+
+    void vector_scaling(benchmark::State& state)
+    {
+        const auto&                   src = batch_words();
+        const std::string             delimiters {" ,"};
+        const parallel_parse::options options {static_cast<unsigned>(state.range(0)), 256 * 1024};
+        for (auto _ : state)
+        {
+            auto result = string2vector::parse_parallel(src, delimiters, options);
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+    }
+
+    const bool registered_parallel = [] {
+        const auto cores = static_cast<int64_t>(std::thread::hardware_concurrency());
+        for (auto* bench : {benchmark::RegisterBenchmark("parse_parallel<multimap>/batch_8m", map_scaling),
+                            benchmark::RegisterBenchmark("string2vector::parse_parallel/batch_8m", vector_scaling)})
+        {
+            int64_t threads = 1;
+            for (; threads <= cores && threads <= 64; threads *= 2)
+                bench->Arg(threads);
+            if (cores > 1 && cores <= 64 && (threads / 2) != cores) bench->Arg(cores);
+            bench->Unit(benchmark::kMillisecond)->UseRealTime();
+        }
+        return true;
+    }();
+} // namespace siddiqsoft::bench
@@ -0,0 +1,109 @@
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "../include/siddiqsoft/parse_batch.hpp"
+#include "corpus.hpp"
+
+
+namespace siddiqsoft::bench
+{
+    /// @brief 100,000 short "key=value&..." log lines of 2 to 8 pairs each.
+    const std::vector<std::string>& log_lines()
+    {
+        static const std::vector<std::string> lines = [] {
+            lcg                      rng;
+            std::vector<std::string> all(100'000);
+            for (auto& line : all)
+            {
+                for (auto pairs = 2 + rng.next(7); pairs > 0; --pairs)
+                    line += "k" + std::to_string(rng.next(32)) + "=" + random_token(rng, 2, 24) + "&";
+            }
+            return all;
+        }();
+        return lines;
+    }
+
+    size_t log_bytes()
+    {
+        size_t total = 0;
+        for (const auto& line : log_lines())
+            total += line.size();
+        return total;
+    }
+
+    /// @brief The baseline: one string2map::parse (and so one container) per line.
+    void batch_per_line_parse(benchmark::State& state)
+    {
+        const auto&       lines = log_lines();
+        const std::string kd {"="}, vd {"&"};
+        for (auto _ : state)
+        {
+            for (const auto& line : lines)
+            {
+                auto result = string2map::parse<std::string, std::string, std::multimap<std::string, std::string>>(line, kd, vd);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * log_bytes()));
+    }
+
+    /// @brief parse_batch into a single arena; state.range(0) threads (0 is the serial overload).
+    void batch_arena(benchmark::State& state)
+    {
+        const auto&                   lines = log_lines();
+        const std::string             kd {"="}, vd {"&"};
+        const parallel_parse::options options {static_cast<unsigned>(state.range(0)), 256 * 1024};
+        for (auto _ : state)
+        {
+            auto result = (state.range(0) == 0) ? string2map::parse_batch<std::string>(lines, kd, vd)
+                                                : string2map::parse_batch<std::string>(lines, kd, vd, {}, options);
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * log_bytes()));
+    }
+
+    /// @brief The log lines as one newline separated buffer.
+    const std::string& log_text()
+    {
+        static const std::string text = [] {
+            std::string all;
+            for (const auto& line : log_lines())
+                all.append(line).push_back('\n');
+            return all;
+        }();
+        return text;
+    }
+
+    /// @brief parse_columns over the log followed by a scan of one column.
+    void batch_columns(benchmark::State& state)
+    {
+        const std::string_view src {log_text()};
+        for (auto _ : state)
+        {
+            auto   table = string2map::parse_columns(src, std::string_view {"\n"}, std::string_view {"="}, std::string_view {"&"});
+            size_t total = 0;
+            for (const auto& cell : table.at("k0").cells())
+                total += cell.is_null() ? 0 : cell.length;
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+    }
+
+    const bool registered_batch = [] {
+        benchmark::RegisterBenchmark("parse_columns/log_lines_100k", batch_columns)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("parse<multimap>/log_lines_100k", batch_per_line_parse)->Unit(benchmark::kMillisecond);
+
+        auto*         bench = benchmark::RegisterBenchmark("parse_batch/log_lines_100k", batch_arena);
+        const int64_t cores = static_cast<int64_t>(std::thread::hardware_concurrency());
+        bench->Arg(0);
+        for (int64_t threads = 2; threads <= cores && threads <= 64; threads *= 2)
+            bench->Arg(threads);
+        bench->Unit(benchmark::kMillisecond)->UseRealTime();
+        return true;
+    }();
+} // namespace siddiqsoft::bench
@@ -0,0 +1,435 @@
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <version>
+#if defined(__cpp_lib_flat_map)
+#include <flat_map>
+#endif
+
+#include "benchmark/benchmark.h"
+
+#include "../include/siddiqsoft/string2map.hpp"
+#include "corpus.hpp"
+
+
+namespace siddiqsoft::bench
+{
+    /// @brief Report throughput as bytes/sec of source parsed (any body after the terminal delimiter is excluded) and pairs/sec.
+    template <typename T> void report(benchmark::State& state, const corpus<T>& c)
+    {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * c.parsedLength * sizeof(typename T::value_type)));
+        state.counters["pairs/s"] =
+                benchmark::Counter(static_cast<double>(state.iterations() * c.pairs), benchmark::Counter::kIsRate);
+    }
+
+    /// @brief string2map::parse for the source type T, destination type D and container R.
+    template <typename T, typename D, typename R> void parse(benchmark::State& state, corpus_id id)
+    {
+        const auto& c = get_corpus<T>(id);
+        for (auto _ : state)
+        {
+            auto result = siddiqsoft::string2map::parse<T, D, R>(c.src, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+            benchmark::DoNotOptimize(result);
+        }
+        report(state, c);
+    }
+
+    /// @brief string2map::parse with the corpus delimiters supplied as compile-time fixed_string parameters.
+    template <typename T> void parse_fixed(benchmark::State& state, corpus_id id)
+    {
+        const auto& c = get_corpus<T>(id);
+        for (auto _ : state)
+        {
+            if (id == corpus_id::long_query)
+            {
+                auto result = siddiqsoft::string2map::parse<"=", "&">(c.src);
+                benchmark::DoNotOptimize(result);
+            }
+            else
+            {
+                auto result = siddiqsoft::string2map::parse<": ", "\r\n", "\r\n\r\n">(c.src);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+        report(state, c);
+    }
+
+    /// @brief string2map::find_value for the key of the pair in the middle of the corpus (the scan stops there).
+    template <typename T> void find_value(benchmark::State& state, corpus_id id)
+    {
+        using view_t    = std::basic_string_view<typename T::value_type>;
+        const auto& c   = get_corpus<T>(id);
+        const auto  all = siddiqsoft::string2map::parse_view<view_t>(c.src, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+        const auto  key = all[all.size() / 2].first;
+        for (auto _ : state)
+        {
+            auto value = siddiqsoft::string2map::find_value<view_t>(c.src, key, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+
+    /// @brief string2map::parse_view into the default vector of views.
+    template <typename T> void parse_view(benchmark::State& state, corpus_id id)
+    {
+        using view_t  = std::basic_string_view<typename T::value_type>;
+        const auto& c = get_corpus<T>(id);
+        for (auto _ : state)
+        {
+            auto result = siddiqsoft::string2map::parse_view<view_t>(c.src, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+            benchmark::DoNotOptimize(result);
+        }
+        report(state, c);
+    }
+
+    /// @brief string2map::parse_fields (trimming and unfolding) into std::map.
+    template <typename T> void parse_fields(benchmark::State& state, corpus_id id)
+    {
+        const auto& c = get_corpus<T>(id);
+        for (auto _ : state)
+        {
+            auto result = siddiqsoft::string2map::parse_fields(c.src, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+            benchmark::DoNotOptimize(result);
+        }
+        report(state, c);
+    }
+
+    /// @brief string2map::stream_parser fed in 512-element chunks.
+    template <typename T> void stream(benchmark::State& state, corpus_id id)
+    {
+        using view_t  = std::basic_string_view<typename T::value_type>;
+        const auto& c = get_corpus<T>(id);
+        for (auto _ : state)
+        {
+            siddiqsoft::string2map::stream_parser<T> parser {c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter};
+            for (size_t offset = 0; offset < c.src.size() && !parser.done(); offset += 512)
+                parser.feed(view_t {c.src}.substr(offset, 512));
+            parser.finish();
+            benchmark::DoNotOptimize(parser.result());
+        }
+        report(state, c);
+    }
+
+    /// @brief string2map::parse_into refilling one long-lived unordered_map (as a per-connection worker would).
+    template <typename T> void parse_into(benchmark::State& state, corpus_id id)
+    {
+        const auto&              c = get_corpus<T>(id);
+        std::unordered_map<T, T> result {};
+        for (auto _ : state)
+        {
+            siddiqsoft::string2map::parse_into(result, c.src, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+            benchmark::DoNotOptimize(result);
+        }
+        report(state, c);
+    }
+
+    /// @brief Parse once then look up every key of the corpus (in source order) in the container R.
+    template <typename T, typename D, typename R> void lookup(benchmark::State& state, corpus_id id)
+    {
+        const auto& c      = get_corpus<T>(id);
+        const auto  result = siddiqsoft::string2map::parse<T, D, R>(c.src, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+        std::vector<D> keys {};
+        for (const auto& [key, value] : result)
+            keys.emplace_back(key);
+
+        for (auto _ : state)
+        {
+            for (const auto& key : keys)
+            {
+                auto it = result.find(key);
+                benchmark::DoNotOptimize(it);
+            }
+        }
+        state.counters["lookups/s"] =
+                benchmark::Counter(static_cast<double>(state.iterations() * keys.size()), benchmark::Counter::kIsRate);
+    }
+
+    using known_header_map = siddiqsoft::string2map::
+            flat_header_map<char, 32, siddiqsoft::string2map::case_insensitive, siddiqsoft::string2map::well_known_headers>;
+
+    /// @brief Parse once then look up the well-known headers of the corpus by header_id (state.range(0) == 1) or by name.
+    void lookup_known(benchmark::State& state, corpus_id id)
+    {
+        using siddiqsoft::string2map::header_id;
+        using siddiqsoft::string2map::well_known_headers;
+
+        const auto& c      = get_corpus<std::string>(id);
+        const auto  result = siddiqsoft::string2map::parse<std::string, std::string, known_header_map>(
+                c.src, c.keyDelimiter, c.valueDelimiter, c.terminalDelimiter);
+        const header_id ids[] = {header_id::host, header_id::user_agent, header_id::accept, header_id::accept_encoding,
+                                 header_id::connection, header_id::cookie, header_id::content_length};
+
+        for (auto _ : state)
+        {
+            for (auto known : ids)
+            {
+                if (state.range(0) == 1)
+                {
+                    auto value = result.get(known);
+                    benchmark::DoNotOptimize(value);
+                }
+                else
+                {
+                    auto it = result.find(well_known_headers::names[static_cast<size_t>(known)]);
+                    benchmark::DoNotOptimize(it);
+                }
+            }
+        }
+        state.counters["lookups/s"] =
+                benchmark::Counter(static_cast<double>(state.iterations() * std::size(ids)), benchmark::Counter::kIsRate);
+    }
+
+    template <typename T> constexpr const char* type_name()
+    {
+        return std::is_same_v<T, std::string> ? "string" : "wstring";
+    }
+
+    template <typename R> constexpr const char* container_name(const R*)
+    {
+        return "map";
+    }
+    template <typename K, typename V> constexpr const char* container_name(const std::multimap<K, V>*)
+    {
+        return "multimap";
+    }
+    template <typename K, typename V> constexpr const char* container_name(const std::unordered_map<K, V>*)
+    {
+        return "unordered_map";
+    }
+    template <typename C, size_t N> constexpr const char* container_name(const siddiqsoft::string2map::flat_header_map<C, N>*)
+    {
+        return "flat_header_map";
+    }
+    template <typename C, size_t N>
+    constexpr const char* container_name(const siddiqsoft::string2map::flat_header_map<C, N, siddiqsoft::string2map::case_insensitive>*)
+    {
+        return "flat_header_map<ci>";
+    }
+    template <typename C, size_t N>
+    constexpr const char* container_name(const siddiqsoft::string2map::flat_header_map<C,
+                                                                                      N,
+                                                                                      siddiqsoft::string2map::case_insensitive,
+                                                                                      siddiqsoft::string2map::well_known_headers>*)
+    {
+        return "flat_header_map<ci,known>";
+    }
+    template <typename K, typename V>
+    constexpr const char* container_name(const std::unordered_map<K, V, siddiqsoft::string2map::ci_hash, siddiqsoft::string2map::ci_equal>*)
+    {
+        return "unordered_map<ci>";
+    }
+#if defined(__cpp_lib_flat_map)
+    template <typename K, typename V> constexpr const char* container_name(const std::flat_map<K, V>*)
+    {
+        return "flat_map";
+    }
+    template <typename K, typename V> constexpr const char* container_name(const std::flat_multimap<K, V>*)
+    {
+        return "flat_multimap";
+    }
+#endif
+
+    template <typename T, typename D, typename R> void register_parse()
+    {
+        for (auto id : all_corpora)
+        {
+            const auto name = std::string("parse<") + type_name<T>() + "," + type_name<D>() + "," +
+                              container_name(static_cast<const R*>(nullptr)) + ">/" + corpus_name(id);
+            benchmark::RegisterBenchmark(name.c_str(), parse<T, D, R>, id);
+        }
+    }
+
+    template <typename T, typename R> void register_lookup()
+    {
+        using D = typename siddiqsoft::string2map::internal_helpers::destination_of<R>::type;
+        for (auto id : all_corpora)
+        {
+            const auto name = std::string("lookup<") + type_name<T>() + "," + container_name(static_cast<const R*>(nullptr)) + ">/" +
+                              corpus_name(id);
+            benchmark::RegisterBenchmark(name.c_str(), lookup<T, D, R>, id);
+        }
+    }
+
+    template <typename T, typename D> void register_containers()
+    {
+        register_parse<T, D, std::map<D, D>>();
+        register_parse<T, D, std::multimap<D, D>>();
+        register_parse<T, D, std::unordered_map<D, D>>();
+        register_parse<T, D, siddiqsoft::string2map::flat_header_map<typename D::value_type>>();
+#if defined(__cpp_lib_flat_map)
+        register_parse<T, D, std::flat_map<D, D>>();
+        register_parse<T, D, std::flat_multimap<D, D>>();
+#endif
+    }
+
+    template <typename T> void register_modes()
+    {
+        for (auto id : all_corpora)
+        {
+            benchmark::RegisterBenchmark((std::string("parse_view<") + type_name<T>() + ">/" + corpus_name(id)).c_str(), parse_view<T>, id);
+            benchmark::RegisterBenchmark((std::string("find_value<") + type_name<T>() + ">/" + corpus_name(id)).c_str(), find_value<T>, id);
+            benchmark::RegisterBenchmark((std::string("parse_fixed<") + type_name<T>() + ",map>/" + corpus_name(id)).c_str(), parse_fixed<T>, id);
+            benchmark::RegisterBenchmark((std::string("stream_parser<") + type_name<T>() + ">/" + corpus_name(id)).c_str(), stream<T>, id);
+            benchmark::RegisterBenchmark((std::string("parse_fields<") + type_name<T>() + ",map>/" + corpus_name(id)).c_str(), parse_fields<T>, id);
+            benchmark::RegisterBenchmark((std::string("parse_into<") + type_name<T>() + ",unordered_map>/" + corpus_name(id)).c_str(),
+                                         parse_into<T>,
+                                         id);
+        }
+    }
+
+    /// @brief The long query string with every '.' percent-encoded and '-' written as '+' (escapes in most pairs).
+    const std::string& encoded_query()
+    {
+        static const std::string text = [] {
+            std::string encoded;
+            for (char ch : get_corpus<std::string>(corpus_id::long_query).src)
+            {
+                if (ch == '.')
+                    encoded += "%2E";
+                else
+                    encoded.push_back((ch == '-') ? '+' : ch);
+            }
+            return encoded;
+        }();
+        return text;
+    }
+
+    const std::string& query_source(bool encoded) { return encoded ? encoded_query() : get_corpus<std::string>(corpus_id::long_query).src; }
+
+    /// @brief The two pass baseline: parse, then decode every key and value into a second map.
+    void query_two_pass(benchmark::State& state, bool encoded)
+    {
+        const auto& src = query_source(encoded);
+        std::string scratch {};
+        for (auto _ : state)
+        {
+            std::map<std::string, std::string> decoded {};
+            for (auto& [key, value] : siddiqsoft::string2map::parse(src, std::string {"="}, std::string {"&"}))
+            {
+                std::string k {siddiqsoft::string2map::url_decode(std::string_view {key}, scratch)};
+                decoded.emplace(std::move(k), siddiqsoft::string2map::url_decode(std::string_view {value}, scratch));
+            }
+            benchmark::DoNotOptimize(decoded);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+    }
+
+    /// @brief string2map::parse_query decoding during the scan.
+    void query_fused(benchmark::State& state, bool encoded)
+    {
+        const auto& src = query_source(encoded);
+        for (auto _ : state)
+        {
+            auto decoded = siddiqsoft::string2map::parse_query(src);
+            benchmark::DoNotOptimize(decoded);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+    }
+
+    /// @brief Allocations made through counting_allocator; arrays are the allocations of more than one element (the
+    ///        vector storage) so each regrowth counts once.
+    struct allocation_counts
+    {
+        size_t all {};
+        size_t arrays {};
+    };
+    inline allocation_counts counted {};
+
+    template <typename V> struct counting_allocator
+    {
+        using value_type = V;
+
+        counting_allocator() = default;
+        template <typename U> counting_allocator(const counting_allocator<U>&) noexcept { }
+
+        V* allocate(size_t n)
+        {
+            ++counted.all;
+            if (n > 1) ++counted.arrays;
+            return std::allocator<V> {}.allocate(n);
+        }
+
+        void deallocate(V* p, size_t n) noexcept { std::allocator<V> {}.deallocate(p, n); }
+
+        template <typename U> bool operator==(const counting_allocator<U>&) const noexcept { return true; }
+    };
+
+    using view_pair      = std::pair<std::string_view, std::string_view>;
+    using counted_vector = std::vector<view_pair, counting_allocator<view_pair>>;
+
+    /// @brief The container allocations per parse: parse_view reserves from the count of value delimiters while the
+    ///        baseline inserts the same pairs into a default constructed container and grows as it goes.
+    void growth(benchmark::State& state, corpus_id id, bool reserved)
+    {
+        const auto&            c = get_corpus<std::string>(id);
+        const std::string_view src {c.src};
+        const std::string_view keyDelimiter {c.keyDelimiter};
+        const std::string_view valueDelimiter {c.valueDelimiter};
+        const std::string_view terminalDelimiter {c.terminalDelimiter};
+
+        counted = {};
+        for (auto _ : state)
+        {
+            counted_vector result {};
+            if (reserved)
+            {
+                result = siddiqsoft::string2map::parse_view<std::string_view, counted_vector>(
+                        src, keyDelimiter, valueDelimiter, terminalDelimiter);
+            }
+            else
+            {
+                siddiqsoft::string2map::for_each_pair(
+                        src, keyDelimiter, valueDelimiter, terminalDelimiter, [&](std::string_view key, std::string_view value) {
+                            result.emplace_back(key, value);
+                        });
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        report(state, c);
+        state.counters["allocs"]  = benchmark::Counter(static_cast<double>(counted.all), benchmark::Counter::kAvgIterations);
+        state.counters["arrays"]  = benchmark::Counter(static_cast<double>(counted.arrays), benchmark::Counter::kAvgIterations);
+    }
+
+    /// @brief Every supported T/D/R combination plus the alternative parse modes for comparison.
+    const bool registered = [] {
+        register_containers<std::string, std::string>();
+        register_containers<std::string, std::wstring>();
+        register_containers<std::wstring, std::wstring>();
+        register_containers<std::wstring, std::string>();
+        register_modes<std::string>();
+        register_modes<std::wstring>();
+        for (bool encoded : {false, true})
+        {
+            const std::string corpus = encoded ? "long_query_encoded" : "long_query";
+            benchmark::RegisterBenchmark(("parse+url_decode<string>/" + corpus).c_str(), query_two_pass, encoded);
+            benchmark::RegisterBenchmark(("parse_query<string>/" + corpus).c_str(), query_fused, encoded);
+        }
+        for (auto id : all_corpora)
+        {
+            for (bool reserved : {false, true})
+            {
+                const std::string suffix = std::string(reserved ? "reserved" : "unreserved") + "/" + corpus_name(id);
+                benchmark::RegisterBenchmark(("growth<vector>/" + suffix).c_str(), growth, id, reserved);
+            }
+        }
+        register_lookup<std::string, std::map<std::string, std::string>>();
+        register_lookup<std::string, std::multimap<std::string, std::string>>();
+        register_lookup<std::string, std::unordered_map<std::string, std::string>>();
+        register_lookup<std::string, siddiqsoft::string2map::flat_header_map<char>>();
+        register_lookup<std::string, siddiqsoft::string2map::flat_header_map<char, 32, siddiqsoft::string2map::case_insensitive>>();
+        register_parse<std::string, std::string, known_header_map>();
+        register_lookup<std::string, known_header_map>();
+        for (auto id : {corpus_id::small_request, corpus_id::header_block_8k})
+        {
+            benchmark::RegisterBenchmark((std::string("lookup_known<by_name>/") + corpus_name(id)).c_str(), lookup_known, id)->Arg(0);
+            benchmark::RegisterBenchmark((std::string("lookup_known<by_id>/") + corpus_name(id)).c_str(), lookup_known, id)->Arg(1);
+        }
+        register_lookup<std::string,
+                        std::unordered_map<std::string, std::string, siddiqsoft::string2map::ci_hash, siddiqsoft::string2map::ci_equal>>();
+#if defined(__cpp_lib_flat_map)
+        register_lookup<std::string, std::flat_map<std::string, std::string>>();
+#endif
+        return true;
+    }();
+} // namespace siddiqsoft::bench
@@ -0,0 +1,114 @@
+#include <string>
+#include <string_view>
+
+#include "benchmark/benchmark.h"
+
+#include "../include/siddiqsoft/string2vector.hpp"
+#include "corpus.hpp"
+
+
+namespace siddiqsoft::bench
+{
+    /// @brief Inputs for the splitter along with the delimiter set and the expected number of tokens.
+    template <typename T> struct split_corpus
+    {
+        const char* name;
+        T           src;
+        T           delimiters;
+        size_t      tokens {};
+    };
+
+    template <typename T> const std::vector<split_corpus<T>>& split_corpora()
+    {
+        static const std::vector<split_corpus<T>> all = [] {
+            std::vector<split_corpus<std::string>> narrow;
+            lcg                                    rng;
+
+            // Url path segments.
+            split_corpus<std::string> path {"path_segments", {}, "/", 0};
+            while (path.src.size() < 256)
+            {
+                path.src += "/" + random_token(rng, 2, 16);
+                ++path.tokens;
+            }
+            narrow.push_back(std::move(path));
+
+            // The 8 KB header block split into lines.
+            auto                      headers = make_corpus(corpus_id::header_block_8k);
+            split_corpus<std::string> lines {"header_lines", headers.src, "\r\n", 0};
+            for (size_t pos = lines.src.find_first_not_of("\r\n"); pos != std::string::npos;
+                 pos        = lines.src.find_first_not_of("\r\n", lines.src.find_first_of("\r\n", pos)))
+                ++lines.tokens;
+            narrow.push_back(std::move(lines));
+
+            // Large whitespace/comma/semicolon separated input.
+            split_corpus<std::string> words {"mixed_separators_64k", {}, " \t,;", 0};
+            static constexpr char     separators[] = " \t,;";
+            while (words.src.size() < 64 * 1024)
+            {
+                words.src += random_token(rng, 1, 12);
+                words.src.push_back(separators[rng.next(sizeof(separators) - 1)]);
+                ++words.tokens;
+            }
+            narrow.push_back(std::move(words));
+
+            if constexpr (std::is_same_v<T, std::string>)
+                return narrow;
+            else
+            {
+                std::vector<split_corpus<T>> wide;
+                for (const auto& c : narrow)
+                    wide.push_back({c.name, widen(c.src), widen(c.delimiters), c.tokens});
+                return wide;
+            }
+        }();
+        return all;
+    }
+
+    template <typename T> void split(benchmark::State& state, size_t index)
+    {
+        const auto& c = split_corpora<T>().at(index);
+        for (auto _ : state)
+        {
+            auto result = siddiqsoft::string2vector::parse<T>(c.src, c.delimiters);
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * c.src.size() * sizeof(typename T::value_type)));
+        state.counters["tokens/s"] = benchmark::Counter(static_cast<double>(state.iterations() * c.tokens), benchmark::Counter::kIsRate);
+    }
+
+    template <typename T> void split_lazy(benchmark::State& state, size_t index)
+    {
+        using view_t = std::basic_string_view<typename T::value_type>;
+
+        const auto& c = split_corpora<T>().at(index);
+        for (auto _ : state)
+        {
+            size_t length = 0;
+            for (auto token : siddiqsoft::string2vector::split_view {view_t {c.src}, view_t {c.delimiters}})
+                length += token.size();
+            benchmark::DoNotOptimize(length);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * c.src.size() * sizeof(typename T::value_type)));
+        state.counters["tokens/s"] = benchmark::Counter(static_cast<double>(state.iterations() * c.tokens), benchmark::Counter::kIsRate);
+    }
+
+    const bool registeredSplit = [] {
+        for (size_t i = 0; i < split_corpora<std::string>().size(); ++i)
+        {
+            benchmark::RegisterBenchmark((std::string("string2vector<string>/") + split_corpora<std::string>()[i].name).c_str(),
+                                         split<std::string>,
+                                         i);
+            benchmark::RegisterBenchmark((std::string("string2vector<wstring>/") + split_corpora<std::wstring>()[i].name).c_str(),
+                                         split<std::wstring>,
+                                         i);
+            benchmark::RegisterBenchmark((std::string("split_view<string>/") + split_corpora<std::string>()[i].name).c_str(),
+                                         split_lazy<std::string>,
+                                         i);
+            benchmark::RegisterBenchmark((std::string("split_view<wstring>/") + split_corpora<std::wstring>()[i].name).c_str(),
+                                         split_lazy<std::wstring>,
+                                         i);
+        }
+        return true;
+    }();
+} // namespace siddiqsoft::bench
@@ -0,0 +1,89 @@
+#include <cwchar>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "../include/siddiqsoft/utf_transcode.hpp"
+#include "corpus.hpp"
+
+
+namespace siddiqsoft::bench
+{
+    /// @brief UTF-8 text: the (ASCII) corpus source or the same text with a two, three and four byte sequence every 16 bytes.
+    const std::string& utf8_text(corpus_id id, bool mixed)
+    {
+        static const auto build = [](bool withMultibyte) {
+            std::vector<std::string> all;
+            for (auto id : all_corpora)
+            {
+                const auto& src = get_corpus<std::string>(id).src;
+                std::string text;
+                for (size_t i = 0; i < src.size(); ++i)
+                {
+                    text.push_back(src[i]);
+                    if (withMultibyte && (i % 16) == 15) text += (i % 48 == 15) ? "\xc3\xa9" : (i % 48 == 31) ? "\xe2\x82\xac" : "\xf0\x9f\x98\x80";
+                }
+                all.push_back(std::move(text));
+            }
+            return all;
+        };
+        static const std::vector<std::string> ascii = build(false);
+        static const std::vector<std::string> multi = build(true);
+        return (mixed ? multi : ascii)[static_cast<int>(id)];
+    }
+
+    void to_wide(benchmark::State& state, corpus_id id, bool mixed)
+    {
+        const auto&  src = utf8_text(id, mixed);
+        std::wstring dst;
+        for (auto _ : state)
+        {
+            siddiqsoft::utf::utf8_to_wide(src, dst);
+            benchmark::DoNotOptimize(dst);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+    }
+
+    void to_utf8(benchmark::State& state, corpus_id id, bool mixed)
+    {
+        const auto  src = siddiqsoft::utf::to_wide(utf8_text(id, mixed));
+        std::string dst;
+        for (auto _ : state)
+        {
+            siddiqsoft::utf::wide_to_utf8(src, dst);
+            benchmark::DoNotOptimize(dst);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size() * sizeof(wchar_t)));
+    }
+
+    /// @brief The previous mbsrtowcs based conversion (ASCII only as it depends on the C locale) for comparison.
+    void mbsrtowcs_baseline(benchmark::State& state, corpus_id id)
+    {
+        const auto& src = utf8_text(id, false);
+        for (auto _ : state)
+        {
+            std::mbstate_t       mbstate {};
+            const char*          p   = src.c_str();
+            const size_t         len = std::mbsrtowcs(nullptr, &p, 0, &mbstate);
+            std::vector<wchar_t> buffer(len + 1);
+            std::wstring         dst {buffer.data(), std::mbsrtowcs(buffer.data(), &p, buffer.size(), &mbstate)};
+            benchmark::DoNotOptimize(dst);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * src.size()));
+    }
+
+    const bool registered_transcode = [] {
+        for (auto id : all_corpora)
+        {
+            const std::string suffix = std::string("/") + corpus_name(id);
+            benchmark::RegisterBenchmark(("utf8_to_wide/ascii" + suffix).c_str(), to_wide, id, false);
+            benchmark::RegisterBenchmark(("utf8_to_wide/mixed" + suffix).c_str(), to_wide, id, true);
+            benchmark::RegisterBenchmark(("wide_to_utf8/ascii" + suffix).c_str(), to_utf8, id, false);
+            benchmark::RegisterBenchmark(("wide_to_utf8/mixed" + suffix).c_str(), to_utf8, id, true);
+            benchmark::RegisterBenchmark(("mbsrtowcs/ascii" + suffix).c_str(), mbsrtowcs_baseline, id);
+        }
+        return true;
+    }();
+} // namespace siddiqsoft::bench
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/// @brief Reproducible inputs shared by the benchmarks.
+/// The generators use a fixed seed and their own integer arithmetic (no std distributions) so every platform and
+/// standard library produces byte-identical corpora.
+namespace siddiqsoft::bench
+{
+    enum class corpus_id : int
+    {
+        /// @brief A typical browser request header block (~500 bytes)
+        small_request = 0,
+        /// @brief An 8 KB header block with many custom headers followed by a body
+        header_block_8k = 1,
+        /// @brief A long (~4 KB) url query string
+        long_query = 2
+    };
+
+    inline constexpr corpus_id all_corpora[] = {corpus_id::small_request, corpus_id::header_block_8k, corpus_id::long_query};
+
+    inline const char* corpus_name(corpus_id id)
+    {
+        switch (id)
+        {
+        case corpus_id::small_request: return "small_request";
+        case corpus_id::header_block_8k: return "header_block_8k";
+        case corpus_id::long_query: return "long_query";
+        }
+        return "unknown";
+    }
+
+    /// @brief Minimal linear congruential generator (Knuth MMIX constants); deterministic everywhere.
+    struct lcg
+    {
+        std::uint64_t state {0x5eed2020u};
+
+        std::uint32_t next(std::uint32_t bound)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<std::uint32_t>(state >> 33) % bound;
+        }
+    };
+
+    inline std::string random_token(lcg& rng, std::uint32_t minLength, std::uint32_t maxLength)
+    {
+        static constexpr char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_.";
+        std::string           token;
+        for (std::uint32_t i = 0, len = minLength + rng.next(maxLength - minLength + 1); i < len; ++i)
+            token.push_back(alphabet[rng.next(sizeof(alphabet) - 1)]);
+        return token;
+    }
+
+    /// @brief A corpus in the source type T together with the delimiters used to parse it.
+    template <typename T> struct corpus
+    {
+        T      src;
+        T      keyDelimiter;
+        T      valueDelimiter;
+        T      terminalDelimiter;
+        size_t pairs {};
+        /// @brief Elements up to and including the terminal delimiter (any body that follows is not parsed)
+        size_t parsedLength {};
+    };
+
+    inline corpus<std::string> make_corpus(corpus_id id)
+    {
+        lcg rng;
+
+        switch (id)
+        {
+        case corpus_id::small_request:
+            return {"Host: www.example.com\r\n"
+                    "User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0 Safari/537.36\r\n"
+                    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+                    "Accept-Language: en-US,en;q=0.9\r\n"
+                    "Accept-Encoding: gzip, deflate, br\r\n"
+                    "Connection: keep-alive\r\n"
+                    "Cookie: session=4f1c2a9b7d; theme=dark; tz=America/New_York\r\n"
+                    "Upgrade-Insecure-Requests: 1\r\n"
+                    "Cache-Control: max-age=0\r\n"
+                    "\r\n",
+                    ": ",
+                    "\r\n",
+                    "\r\n\r\n",
+                    9,
+                    0};
+
+        case corpus_id::header_block_8k:
+        {
+            corpus<std::string> c {{}, ": ", "\r\n", "\r\n\r\n", 0, 0};
+            while (c.src.size() < 8 * 1024)
+            {
+                c.src += "X-" + random_token(rng, 4, 24) + ": " + random_token(rng, 8, 120) + "\r\n";
+                ++c.pairs;
+            }
+            c.src += "\r\n";
+            c.parsedLength = c.src.size();
+            // A body which must not be examined by the parser.
+            for (int i = 0; i < 64; ++i)
+                c.src += "body: " + random_token(rng, 32, 64) + "\r\n";
+            return c;
+        }
+
+        case corpus_id::long_query:
+        {
+            corpus<std::string> c {{}, "=", "&", "", 0, 0};
+            while (c.src.size() < 4 * 1024)
+            {
+                if (!c.src.empty()) c.src += "&";
+                c.src += random_token(rng, 2, 12) + "=" + random_token(rng, 0, 40);
+                ++c.pairs;
+            }
+            return c;
+        }
+        }
+        return {};
+    }
+
+    /// @brief Widen an ASCII corpus.
+    inline std::wstring widen(std::string_view s) { return {s.begin(), s.end()}; }
+
+    /// @brief The corpus in the requested source type; built once.
+    template <typename T> const corpus<T>& get_corpus(corpus_id id)
+    {
+        static const std::vector<corpus<T>> all = [] {
+            std::vector<corpus<T>> result;
+            for (auto id : all_corpora)
+            {
+                auto c = make_corpus(id);
+                if (c.parsedLength == 0) c.parsedLength = c.src.size();
+                if constexpr (std::is_same_v<T, std::string>)
+                    result.push_back(std::move(c));
+                else
+                    result.push_back({widen(c.src), widen(c.keyDelimiter), widen(c.valueDelimiter), widen(c.terminalDelimiter), c.pairs, c.parsedLength});
+            }
+            return result;
+        }();
+        return all.at(static_cast<size_t>(id));
+    }
+} // namespace siddiqsoft::bench
@@ -0,0 +1,149 @@
+/*
+	Case-insensitive Key Policies
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+
+namespace siddiqsoft::string2map
+{
+    namespace internal_helpers
+    {
+        /// @brief ASCII case folding; HTTP field names and query keys are ASCII tokens so no locale is involved.
+        template <typename C> constexpr C fold_ascii(C ch) noexcept
+        {
+            // A single unsigned comparison covers the range check; 'a' - 'A' is the 0x20 bit.
+            return (static_cast<std::make_unsigned_t<C>>(ch - C('A')) < 26u) ? static_cast<C>(ch | C(0x20)) : ch;
+        }
+
+        /// @brief The view type for a string, view or character array argument.
+        template <typename S>
+        using view_of_t = std::basic_string_view<std::remove_cv_t<std::remove_pointer_t<std::decay_t<decltype(std::data(std::declval<const S&>()))>>>>;
+    } // namespace internal_helpers
+
+
+    /// @brief Key policy which compares keys verbatim (the default for flat_header_map).
+    struct case_sensitive
+    {
+        template <typename C> static constexpr C fold(C ch) noexcept { return ch; }
+
+        template <typename C> static constexpr bool equal(std::basic_string_view<C> a, std::basic_string_view<C> b) noexcept { return a == b; }
+    };
+
+
+    /// @brief Key policy which folds ASCII letters so "Content-Length" and "content-length" are the same key.
+    ///        The key is stored as it appeared in the source; only the hash and comparisons are folded.
+    struct case_insensitive
+    {
+        template <typename C> static constexpr C fold(C ch) noexcept { return internal_helpers::fold_ascii(ch); }
+
+        template <typename C> static constexpr bool equal(std::basic_string_view<C> a, std::basic_string_view<C> b) noexcept
+        {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                if (fold(a[i]) != fold(b[i])) return false;
+            }
+            return true;
+        }
+    };
+
+
+    /// @brief FNV-1a hash of the key after folding each element through the policy.
+    template <typename Policy, typename C> constexpr std::uint32_t key_hash(std::basic_string_view<C> key) noexcept
+    {
+        std::uint32_t h = 2166136261u;
+        for (auto ch : key)
+        {
+            h ^= static_cast<std::uint32_t>(Policy::fold(ch));
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+
+    /// @brief Transparent case-insensitive hash for std::unordered_map<std::string, ...> (or wstring) keys.
+    ///        Use with ci_equal; lookups by std::string_view or literal do not allocate or build a lowercase copy.
+    struct ci_hash
+    {
+        using is_transparent = void;
+
+        template <typename S> constexpr size_t operator()(const S& key) const noexcept
+        {
+            return key_hash<case_insensitive>(internal_helpers::view_of_t<S> {key});
+        }
+    };
+
+
+    /// @brief Transparent case-insensitive equality for std::unordered_map keys.
+    struct ci_equal
+    {
+        using is_transparent = void;
+
+        template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const noexcept
+        {
+            return case_insensitive::equal(internal_helpers::view_of_t<A> {a}, internal_helpers::view_of_t<B> {b});
+        }
+    };
+
+
+    /// @brief Transparent case-insensitive ordering for std::map and std::multimap keys.
+    struct ci_less
+    {
+        using is_transparent = void;
+
+        template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const noexcept
+        {
+            const internal_helpers::view_of_t<A> x {a};
+            const internal_helpers::view_of_t<B> y {b};
+            for (size_t i = 0; i < x.size() && i < y.size(); ++i)
+            {
+                const auto l = case_insensitive::fold(x[i]);
+                const auto r = case_insensitive::fold(y[i]);
+                if (l != r) return l < r;
+            }
+            return x.size() < y.size();
+        }
+    };
+} // namespace siddiqsoft::string2map
@@ -0,0 +1,1013 @@
+/*
+	Delimiter Scanning Kernels
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIDDIQSOFT_DELIMITER_SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// The AVX2 kernels are compiled for the AVX2 target regardless of the global compiler flags and are
+// only invoked when the runtime check confirms support.
+#if defined(SIDDIQSOFT_DELIMITER_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2
+#define SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2
+#endif
+
+
+namespace siddiqsoft::delimiter_scan
+{
+    /// @brief The instruction set used by the scanning kernels.
+    enum class simd_level : int
+    {
+        scalar = 0,
+        sse2   = 1,
+        avx2   = 2
+    };
+
+    /// @brief Result of a search for one of two delimiters.
+    struct match
+    {
+        static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+        /// @brief Position of the match; npos (same as none) when neither delimiter was found
+        std::size_t position {none};
+        /// @brief Index of the delimiter which matched (0 for the first, 1 for the second) or none
+        std::size_t needle {none};
+
+        constexpr bool found() const noexcept { return needle != none; }
+    };
+
+    /// @brief A string literal usable as a non-type template parameter, for delimiters known at compile time.
+    ///        Example: parse<": ", "\r\n", "\r\n\r\n">(src)
+    /// @tparam C Character type of the literal
+    /// @tparam N Length of the literal including the terminating null
+    template <typename C, std::size_t N> struct fixed_string
+    {
+        C value[N] {};
+
+        constexpr fixed_string(const C (&str)[N]) noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                value[i] = str[i];
+        }
+
+        constexpr std::size_t size() const noexcept { return N - 1; }
+    };
+
+    /// @brief A set of single element delimiters (any one of which separates tokens) prepared once for repeated searches.
+    ///        Elements below 256 are held in a 256-bit bitmap laid out for the nibble shuffle lookup of the AVX2 kernel:
+    ///        byte lo of the first half has bit h set when (h << 4 | lo) is a member (h 0-7) and the second half covers
+    ///        h 8-15. Wide elements beyond 255 are matched against the original delimiters.
+    /// @tparam C char or wchar_t
+    /// @remarks The delimiters must outlive the set.
+    template <typename C> class delimiter_set
+    {
+    public:
+        /// @brief The largest set searched by comparing each element against the whole block; larger sets use the
+        ///        bitmap (with the shuffle lookup for char at the AVX2 level).
+        static constexpr std::size_t max_compare_elements = 8;
+
+        constexpr delimiter_set() noexcept = default;
+
+        constexpr explicit delimiter_set(std::basic_string_view<C> delimiters) noexcept
+            : elements_(delimiters)
+        {
+            for (C c : delimiters)
+            {
+                const auto u = static_cast<std::make_unsigned_t<C>>(c);
+                if (u < 256)
+                    bitmap_[((u >> 7) << 4) | (u & 0x0F)] |= static_cast<std::uint8_t>(1u << ((u >> 4) & 0x07));
+                else
+                    beyondBitmap_ = true;
+            }
+        }
+
+        constexpr bool contains(C c) const noexcept
+        {
+            const auto u = static_cast<std::make_unsigned_t<C>>(c);
+            if (u < 256) return ((bitmap_[((u >> 7) << 4) | (u & 0x0F)] >> ((u >> 4) & 0x07)) & 1u) != 0;
+            return beyondBitmap_ && (elements_.find(c) != std::basic_string_view<C>::npos);
+        }
+
+        constexpr std::basic_string_view<C> elements() const noexcept { return elements_; }
+
+        constexpr const std::array<std::uint8_t, 32>& bitmap() const noexcept { return bitmap_; }
+
+    private:
+        std::basic_string_view<C>    elements_ {};
+        std::array<std::uint8_t, 32> bitmap_ {};
+        bool                         beyondBitmap_ {false};
+    };
+
+    namespace internal_helpers
+    {
+        /// @brief Static storage for a fixed_string converted to the character type of the source.
+        template <typename C, auto S> struct fixed_storage
+        {
+            static constexpr std::array<C, S.size() + 1> value = [] {
+                std::array<C, S.size() + 1> result {};
+                for (std::size_t i = 0; i < S.size(); ++i)
+                    result[i] = static_cast<C>(S.value[i]);
+                return result;
+            }();
+        };
+
+        /// @brief Detect the best instruction set available on this cpu (and enabled by the OS).
+        inline simd_level detect_level() noexcept
+        {
+#if defined(SIDDIQSOFT_DELIMITER_SCAN_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+            int regs[4] {};
+            __cpuid(regs, 0);
+            if (regs[0] < 7) return simd_level::sse2;
+            __cpuid(regs, 1);
+            // OSXSAVE and AVX are required before we may query the extended state.
+            const bool osxsave = (regs[2] & (1 << 27)) != 0;
+            const bool avx     = (regs[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || ((_xgetbv(0) & 0x6) != 0x6)) return simd_level::sse2;
+            __cpuidex(regs, 7, 0);
+            return (regs[1] & (1 << 5)) != 0 ? simd_level::avx2 : simd_level::sse2;
+#else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+            if (__builtin_cpu_supports("sse2")) return simd_level::sse2;
+#endif
+#endif
+            return simd_level::scalar;
+        }
+
+        /// @brief The level used by the dispatching functions. Shared across translation units.
+        inline std::atomic<simd_level>& active_level_storage() noexcept
+        {
+            static std::atomic<simd_level> level {detect_level()};
+            return level;
+        }
+
+        template <typename C> constexpr bool equal_tail(const C* a, const C* b, std::size_t count) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (a[i] != b[i]) return false;
+            }
+            return true;
+        }
+
+        /// @brief Reference implementation; also used for the tail of the vectorized kernels.
+        template <typename C>
+        constexpr std::size_t
+        find_scalar(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from) noexcept
+        {
+            // GCC does not accept the library search over static storage (literal parsing) when -fsanitize=undefined instruments it.
+            if (std::is_constant_evaluated())
+            {
+                if (needle.size() > src.size()) return std::basic_string_view<C>::npos;
+                for (std::size_t pos = from; pos <= src.size() - needle.size(); ++pos)
+                {
+                    if (equal_tail(src.data() + pos, needle.data(), needle.size())) return pos;
+                }
+                return std::basic_string_view<C>::npos;
+            }
+            return src.find(needle, from);
+        }
+
+        /// @brief Reference implementation of find_either; also used for the tail of the vectorized kernels.
+        template <typename C>
+        constexpr match find_either_scalar(std::basic_string_view<C> src,
+                                           std::basic_string_view<C> first,
+                                           std::size_t               firstFrom,
+                                           std::basic_string_view<C> second,
+                                           std::size_t               secondFrom) noexcept
+        {
+            const std::size_t n = src.size();
+
+            for (std::size_t i = (firstFrom < secondFrom) ? firstFrom : secondFrom; i < n; ++i)
+            {
+                if (i >= firstFrom && first.size() <= n - i && src[i] == first.front() &&
+                    equal_tail(src.data() + i + 1, first.data() + 1, first.size() - 1))
+                    return {i, 0};
+                if (i >= secondFrom && second.size() <= n - i && src[i] == second.front() &&
+                    equal_tail(src.data() + i + 1, second.data() + 1, second.size() - 1))
+                    return {i, 1};
+            }
+            return {};
+        }
+
+        /// @brief Reference implementation of the delimiter set searches (Member selects find_first_of over
+        ///        find_first_not_of); also used for the tail of the vectorized kernels.
+        template <bool Member, typename C>
+        constexpr std::size_t find_in_set_scalar(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from) noexcept
+        {
+            for (std::size_t i = from; i < src.size(); ++i)
+            {
+                if (set.contains(src[i]) == Member) return i;
+            }
+            return std::basic_string_view<C>::npos;
+        }
+
+        /// @brief Reference implementation of count; also used for the tail of the vectorized kernels.
+        template <typename C>
+        constexpr std::size_t
+        count_scalar(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from) noexcept
+        {
+            std::size_t result = 0;
+            if (needle.empty()) return result;
+            for (auto pos = find_scalar(src, needle, from); pos != std::basic_string_view<C>::npos;
+                 pos = find_scalar(src, needle, pos + needle.size()))
+                ++result;
+            return result;
+        }
+
+#if defined(SIDDIQSOFT_DELIMITER_SCAN_X86)
+        /// @brief Element-size specific compare and movemask for 128-bit blocks.
+        template <typename C> SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2 inline __m128i broadcast128(C c) noexcept
+        {
+            if constexpr (sizeof(C) == 1)
+                return _mm_set1_epi8(static_cast<char>(c));
+            else if constexpr (sizeof(C) == 2)
+                return _mm_set1_epi16(static_cast<short>(c));
+            else
+                return _mm_set1_epi32(static_cast<int>(c));
+        }
+
+        template <typename C> SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2 inline __m128i compare128(__m128i a, __m128i b) noexcept
+        {
+            if constexpr (sizeof(C) == 1)
+                return _mm_cmpeq_epi8(a, b);
+            else if constexpr (sizeof(C) == 2)
+                return _mm_cmpeq_epi16(a, b);
+            else
+                return _mm_cmpeq_epi32(a, b);
+        }
+
+        template <typename C> SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 inline __m256i broadcast256(C c) noexcept
+        {
+            if constexpr (sizeof(C) == 1)
+                return _mm256_set1_epi8(static_cast<char>(c));
+            else if constexpr (sizeof(C) == 2)
+                return _mm256_set1_epi16(static_cast<short>(c));
+            else
+                return _mm256_set1_epi32(static_cast<int>(c));
+        }
+
+        template <typename C> SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 inline __m256i compare256(__m256i a, __m256i b) noexcept
+        {
+            if constexpr (sizeof(C) == 1)
+                return _mm256_cmpeq_epi8(a, b);
+            else if constexpr (sizeof(C) == 2)
+                return _mm256_cmpeq_epi16(a, b);
+            else
+                return _mm256_cmpeq_epi32(a, b);
+        }
+
+        inline unsigned lowest_bit(std::uint32_t mask) noexcept
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index {};
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+
+        /// @brief Walk the candidate bits of a block; each element owns sizeof(C) bits in the mask.
+        /// @return The position of the first verified match or npos if none in this block.
+        template <typename C>
+        inline std::size_t verify_candidates(std::uint32_t mask, const C* s, std::size_t blockStart, const C* needle, std::size_t m) noexcept
+        {
+            constexpr std::uint32_t laneBits = (sizeof(C) == 4) ? 0xFu : ((sizeof(C) == 2) ? 0x3u : 0x1u);
+
+            while (mask != 0)
+            {
+                const unsigned    bit = lowest_bit(mask);
+                const std::size_t pos = blockStart + (bit / sizeof(C));
+                // First and last elements already matched; verify the middle.
+                if (m <= 2 || equal_tail(s + pos + 1, needle + 1, m - 2)) return pos;
+                mask &= ~(laneBits << bit);
+            }
+            return std::basic_string_view<C>::npos;
+        }
+
+        /// @brief SSE2 kernel: compares the first and the last element of the needle against 16-byte blocks
+        ///        and only verifies the remainder of the needle for the candidate positions.
+        template <typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2 std::size_t
+        find_sse2(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from) noexcept
+        {
+            constexpr std::size_t lanes = 16 / sizeof(C);
+            const std::size_t     n     = src.size();
+            const std::size_t     m     = needle.size();
+
+            if (m == 0 || from > n || (n - from) < m) return find_scalar(src, needle, from);
+
+            const C*      s     = src.data();
+            const __m128i first = broadcast128<C>(needle.front());
+            const __m128i last  = broadcast128<C>(needle.back());
+
+            std::size_t i = from;
+            // Loads at [i, i+lanes) and [i+m-1, i+m-1+lanes) must stay inside the source.
+            for (; i + m - 1 + lanes <= n; i += lanes)
+            {
+                const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                const __m128i blockLast  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+                const auto    mask       = static_cast<std::uint32_t>(
+                        _mm_movemask_epi8(_mm_and_si128(compare128<C>(blockFirst, first), compare128<C>(blockLast, last))));
+                if (mask != 0)
+                {
+                    if (auto pos = verify_candidates<C>(mask, s, i, needle.data(), m); pos != std::basic_string_view<C>::npos)
+                        return pos;
+                }
+            }
+
+            return find_scalar(src, needle, i);
+        }
+
+        /// @brief AVX2 kernel: same strategy as the SSE2 kernel on 32-byte blocks.
+        template <typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 std::size_t
+        find_avx2(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from) noexcept
+        {
+            constexpr std::size_t lanes = 32 / sizeof(C);
+            const std::size_t     n     = src.size();
+            const std::size_t     m     = needle.size();
+
+            if (m == 0 || from > n || (n - from) < m) return find_scalar(src, needle, from);
+
+            const C*      s     = src.data();
+            const __m256i first = broadcast256<C>(needle.front());
+            const __m256i last  = broadcast256<C>(needle.back());
+
+            std::size_t i = from;
+            for (; i + m - 1 + lanes <= n; i += lanes)
+            {
+                const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                const __m256i blockLast  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+                const auto    mask       = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                        _mm256_and_si256(compare256<C>(blockFirst, first), compare256<C>(blockLast, last))));
+                if (mask != 0)
+                {
+                    if (auto pos = verify_candidates<C>(mask, s, i, needle.data(), m); pos != std::basic_string_view<C>::npos)
+                        return pos;
+                }
+            }
+
+            // Finish the remainder with the 16-byte kernel before dropping to scalar.
+            return find_sse2(src, needle, i);
+        }
+
+        /// @brief Verify the candidates of a block against both delimiters; the first delimiter wins a tie.
+        template <typename C>
+        inline match verify_either(std::uint32_t             mask,
+                                   std::basic_string_view<C> src,
+                                   std::size_t               blockStart,
+                                   std::basic_string_view<C> first,
+                                   std::size_t               firstFrom,
+                                   std::basic_string_view<C> second,
+                                   std::size_t               secondFrom) noexcept
+        {
+            constexpr std::uint32_t laneBits = (sizeof(C) == 4) ? 0xFu : ((sizeof(C) == 2) ? 0x3u : 0x1u);
+
+            while (mask != 0)
+            {
+                const unsigned    bit = lowest_bit(mask);
+                const std::size_t pos = blockStart + (bit / sizeof(C));
+                if (pos >= firstFrom && equal_tail(src.data() + pos, first.data(), first.size())) return {pos, 0};
+                if (pos >= secondFrom && equal_tail(src.data() + pos, second.data(), second.size())) return {pos, 1};
+                mask &= ~(laneBits << bit);
+            }
+            return {};
+        }
+
+        /// @brief SSE2 kernel for find_either: a single pass over 16-byte blocks flags the positions where either
+        ///        delimiter's first and last elements match.
+        template <typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2 match find_either_sse2(std::basic_string_view<C> src,
+                                                                     std::basic_string_view<C> first,
+                                                                     std::size_t               firstFrom,
+                                                                     std::basic_string_view<C> second,
+                                                                     std::size_t               secondFrom) noexcept
+        {
+            constexpr std::size_t lanes   = 16 / sizeof(C);
+            const std::size_t     n       = src.size();
+            const std::size_t     longest = (first.size() > second.size()) ? first.size() : second.size();
+            std::size_t           i       = (firstFrom < secondFrom) ? firstFrom : secondFrom;
+
+            if (first.empty() || second.empty() || i > n || (n - i) < longest)
+                return find_either_scalar(src, first, firstFrom, second, secondFrom);
+
+            const C*      s          = src.data();
+            const __m128i firstHead  = broadcast128<C>(first.front());
+            const __m128i firstTail  = broadcast128<C>(first.back());
+            const __m128i secondHead = broadcast128<C>(second.front());
+            const __m128i secondTail = broadcast128<C>(second.back());
+
+            for (; i + longest - 1 + lanes <= n; i += lanes)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                const __m128i a =
+                        _mm_and_si128(compare128<C>(block, firstHead),
+                                      compare128<C>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + first.size() - 1)), firstTail));
+                const __m128i b =
+                        _mm_and_si128(compare128<C>(block, secondHead),
+                                      compare128<C>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + second.size() - 1)), secondTail));
+                if (const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(a, b))); mask != 0)
+                {
+                    if (auto result = verify_either<C>(mask, src, i, first, firstFrom, second, secondFrom); result.found())
+                        return result;
+                }
+            }
+
+            return find_either_scalar(src, first, firstFrom > i ? firstFrom : i, second, secondFrom > i ? secondFrom : i);
+        }
+
+        /// @brief AVX2 kernel for find_either on 32-byte blocks.
+        template <typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 match find_either_avx2(std::basic_string_view<C> src,
+                                                                     std::basic_string_view<C> first,
+                                                                     std::size_t               firstFrom,
+                                                                     std::basic_string_view<C> second,
+                                                                     std::size_t               secondFrom) noexcept
+        {
+            constexpr std::size_t lanes   = 32 / sizeof(C);
+            const std::size_t     n       = src.size();
+            const std::size_t     longest = (first.size() > second.size()) ? first.size() : second.size();
+            std::size_t           i       = (firstFrom < secondFrom) ? firstFrom : secondFrom;
+
+            if (first.empty() || second.empty() || i > n || (n - i) < longest)
+                return find_either_scalar(src, first, firstFrom, second, secondFrom);
+
+            const C*      s          = src.data();
+            const __m256i firstHead  = broadcast256<C>(first.front());
+            const __m256i firstTail  = broadcast256<C>(first.back());
+            const __m256i secondHead = broadcast256<C>(second.front());
+            const __m256i secondTail = broadcast256<C>(second.back());
+
+            for (; i + longest - 1 + lanes <= n; i += lanes)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                const __m256i a =
+                        _mm256_and_si256(compare256<C>(block, firstHead),
+                                         compare256<C>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + first.size() - 1)),
+                                                       firstTail));
+                const __m256i b =
+                        _mm256_and_si256(compare256<C>(block, secondHead),
+                                         compare256<C>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + second.size() - 1)),
+                                                       secondTail));
+                if (const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(a, b))); mask != 0)
+                {
+                    if (auto result = verify_either<C>(mask, src, i, first, firstFrom, second, secondFrom); result.found())
+                        return result;
+                }
+            }
+
+            return find_either_sse2(src, first, firstFrom > i ? firstFrom : i, second, secondFrom > i ? secondFrom : i);
+        }
+
+        /// @brief SSE2 kernel for small delimiter sets: each element is compared against 16-byte blocks and the results
+        ///        are combined. Sets larger than max_compare_elements use the scalar bitmap lookup.
+        template <bool Member, typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2 std::size_t
+        find_in_set_sse2(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from) noexcept
+        {
+            constexpr std::size_t lanes    = 16 / sizeof(C);
+            const auto            elements = set.elements();
+            const std::size_t     m        = elements.size();
+            const std::size_t     n        = src.size();
+
+            if (m == 0 || m > delimiter_set<C>::max_compare_elements) return find_in_set_scalar<Member>(src, set, from);
+
+            __m128i needles[delimiter_set<C>::max_compare_elements];
+            for (std::size_t k = 0; k < m; ++k)
+                needles[k] = broadcast128<C>(elements[k]);
+
+            const C*    s = src.data();
+            std::size_t i = from;
+            for (; i + lanes <= n; i += lanes)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                __m128i       hits  = compare128<C>(block, needles[0]);
+                for (std::size_t k = 1; k < m; ++k)
+                    hits = _mm_or_si128(hits, compare128<C>(block, needles[k]));
+
+                auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+                if constexpr (!Member) mask = ~mask & 0xFFFFu;
+                if (mask != 0) return i + (lowest_bit(mask) / sizeof(C));
+            }
+
+            return find_in_set_scalar<Member>(src, set, i);
+        }
+
+        /// @brief AVX2 kernel for small delimiter sets: same strategy as the SSE2 kernel on 32-byte blocks.
+        template <bool Member, typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 std::size_t
+        find_in_set_avx2(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from) noexcept
+        {
+            constexpr std::size_t lanes    = 32 / sizeof(C);
+            const auto            elements = set.elements();
+            const std::size_t     m        = elements.size();
+            const std::size_t     n        = src.size();
+
+            if (m == 0 || m > delimiter_set<C>::max_compare_elements) return find_in_set_scalar<Member>(src, set, from);
+
+            __m256i needles[delimiter_set<C>::max_compare_elements];
+            for (std::size_t k = 0; k < m; ++k)
+                needles[k] = broadcast256<C>(elements[k]);
+
+            const C*    s = src.data();
+            std::size_t i = from;
+            for (; i + lanes <= n; i += lanes)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                __m256i       hits  = compare256<C>(block, needles[0]);
+                for (std::size_t k = 1; k < m; ++k)
+                    hits = _mm256_or_si256(hits, compare256<C>(block, needles[k]));
+
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+                if constexpr (!Member) mask = ~mask;
+                if (mask != 0) return i + (lowest_bit(mask) / sizeof(C));
+            }
+
+            return find_in_set_sse2<Member>(src, set, i);
+        }
+
+        /// @brief AVX2 kernel classifying 32 bytes at a time against the 256-bit bitmap of any size of char delimiter set.
+        ///        The low nibble of each byte selects a row of the bitmap with vpshufb (from the first or second half
+        ///        depending on the top bit) and the high nibble selects the bit within that row.
+        template <bool Member>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 std::size_t
+        find_in_bitmap_avx2(std::basic_string_view<char> src, const delimiter_set<char>& set, std::size_t from) noexcept
+        {
+            const std::size_t n = src.size();
+            if (set.elements().empty()) return find_in_set_scalar<Member>(src, set, from);
+
+            const auto*   bitmap = reinterpret_cast<const __m128i*>(set.bitmap().data());
+            const __m256i rowsLow  = _mm256_broadcastsi128_si256(_mm_loadu_si128(bitmap));
+            const __m256i rowsHigh = _mm256_broadcastsi128_si256(_mm_loadu_si128(bitmap + 1));
+            const __m256i bits     = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                      1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            const __m256i nibble   = _mm256_set1_epi8(0x0F);
+            const __m256i seven    = _mm256_set1_epi8(7);
+
+            const char* s = src.data();
+            std::size_t i = from;
+            for (; i + 32 <= n; i += 32)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                const __m256i low   = _mm256_and_si256(block, nibble);
+                const __m256i high  = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+                const __m256i row   = _mm256_blendv_epi8(_mm256_shuffle_epi8(rowsLow, low),
+                                                       _mm256_shuffle_epi8(rowsHigh, low),
+                                                       _mm256_cmpgt_epi8(high, seven));
+                const __m256i bit   = _mm256_shuffle_epi8(bits, high);
+                const __m256i hits  = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+                if constexpr (!Member) mask = ~mask;
+                if (mask != 0) return i + lowest_bit(mask);
+            }
+
+            return find_in_set_sse2<Member>(src, set, i);
+        }
+
+        /// @brief Count the verified matches among the candidate bits of a block. A match may not start before next (the
+        ///        end of the previous match) so that overlapping occurrences are counted once, as find would step over them.
+        template <typename C>
+        inline std::size_t count_candidates(
+                std::uint32_t mask, const C* s, std::size_t blockStart, const C* needle, std::size_t m, std::size_t& next) noexcept
+        {
+            constexpr std::uint32_t laneBits = (sizeof(C) == 4) ? 0xFu : ((sizeof(C) == 2) ? 0x3u : 0x1u);
+
+            // A single element needle cannot overlap itself; every candidate is a match.
+            if (m == 1) return static_cast<std::size_t>(std::popcount(mask)) / sizeof(C);
+
+            std::size_t result = 0;
+            while (mask != 0)
+            {
+                const unsigned    bit = lowest_bit(mask);
+                const std::size_t pos = blockStart + (bit / sizeof(C));
+                if (pos >= next && (m <= 2 || equal_tail(s + pos + 1, needle + 1, m - 2)))
+                {
+                    ++result;
+                    next = pos + m;
+                }
+                mask &= ~(laneBits << bit);
+            }
+            return result;
+        }
+
+        /// @brief SSE2 kernel for count: the candidate masks of find_sse2 are counted rather than returned.
+        template <typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_SSE2 std::size_t
+        count_sse2(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from) noexcept
+        {
+            constexpr std::size_t lanes = 16 / sizeof(C);
+            const std::size_t     n     = src.size();
+            const std::size_t     m     = needle.size();
+
+            if (m == 0 || from > n || (n - from) < m) return count_scalar(src, needle, from);
+
+            const C*      s     = src.data();
+            const __m128i first = broadcast128<C>(needle.front());
+            const __m128i last  = broadcast128<C>(needle.back());
+
+            std::size_t result = 0;
+            std::size_t next   = from;
+            std::size_t i      = from;
+            for (; i + m - 1 + lanes <= n; i += lanes)
+            {
+                const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                const __m128i blockLast  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+                const auto    mask       = static_cast<std::uint32_t>(
+                        _mm_movemask_epi8(_mm_and_si128(compare128<C>(blockFirst, first), compare128<C>(blockLast, last))));
+                if (mask != 0) result += count_candidates<C>(mask, s, i, needle.data(), m, next);
+            }
+
+            return result + count_scalar(src, needle, next > i ? next : i);
+        }
+
+        /// @brief AVX2 kernel for count on 32-byte blocks.
+        template <typename C>
+        SIDDIQSOFT_DELIMITER_SCAN_TARGET_AVX2 std::size_t
+        count_avx2(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from) noexcept
+        {
+            constexpr std::size_t lanes = 32 / sizeof(C);
+            const std::size_t     n     = src.size();
+            const std::size_t     m     = needle.size();
+
+            if (m == 0 || from > n || (n - from) < m) return count_scalar(src, needle, from);
+
+            const C*      s     = src.data();
+            const __m256i first = broadcast256<C>(needle.front());
+            const __m256i last  = broadcast256<C>(needle.back());
+
+            std::size_t result = 0;
+            std::size_t next   = from;
+            std::size_t i      = from;
+            for (; i + m - 1 + lanes <= n; i += lanes)
+            {
+                const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                const __m256i blockLast  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+                const auto    mask       = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                        _mm256_and_si256(compare256<C>(blockFirst, first), compare256<C>(blockLast, last))));
+                if (mask != 0) result += count_candidates<C>(mask, s, i, needle.data(), m, next);
+            }
+
+            return result + count_sse2(src, needle, next > i ? next : i);
+        }
+#endif
+
+        /// @brief Dispatch a delimiter set search to the kernel for the given instruction set.
+        template <bool Member, typename C>
+        std::size_t find_in_set(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from, simd_level level) noexcept
+        {
+#if defined(SIDDIQSOFT_DELIMITER_SCAN_X86)
+            if (level == simd_level::avx2)
+            {
+                if constexpr (std::is_same_v<C, char>)
+                    return find_in_bitmap_avx2<Member>(src, set, from);
+                else
+                    return find_in_set_avx2<Member>(src, set, from);
+            }
+            if (level == simd_level::sse2) return find_in_set_sse2<Member>(src, set, from);
+#else
+            (void)level;
+#endif
+            return find_in_set_scalar<Member>(src, set, from);
+        }
+    } // namespace internal_helpers
+
+
+    /// @brief The instruction set currently used by the dispatching functions.
+    inline simd_level active_level() noexcept
+    {
+        return internal_helpers::active_level_storage().load(std::memory_order_relaxed);
+    }
+
+    /// @brief The best instruction set supported by this cpu.
+    inline simd_level supported_level() noexcept
+    {
+        static const simd_level supported = internal_helpers::detect_level();
+        return supported;
+    }
+
+    /// @brief Select the instruction set used by the dispatching functions (used by tests and benchmarks to compare
+    ///        against the scalar path). The request is clamped to what the cpu supports.
+    /// @return The level now in effect
+    inline simd_level set_active_level(simd_level level) noexcept
+    {
+        const simd_level effective = (static_cast<int>(level) > static_cast<int>(supported_level())) ? supported_level() : level;
+        internal_helpers::active_level_storage().store(effective, std::memory_order_relaxed);
+        return effective;
+    }
+
+    /// @brief Locate the first occurrence of needle in src at or after from using the given instruction set.
+    ///        The level must not exceed supported_level().
+    /// @return Position of the match or npos; identical to std::basic_string_view::find
+    template <typename C>
+    static std::size_t
+    find(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from, simd_level level) noexcept
+    {
+#if defined(SIDDIQSOFT_DELIMITER_SCAN_X86)
+        if (level == simd_level::avx2) return internal_helpers::find_avx2(src, needle, from);
+        if (level == simd_level::sse2) return internal_helpers::find_sse2(src, needle, from);
+#else
+        (void)level;
+#endif
+        return internal_helpers::find_scalar(src, needle, from);
+    }
+
+    /// @brief Locate the first occurrence of needle in src at or after from.
+    ///        Uses the vectorized kernel selected at runtime; the constant-evaluated path is scalar.
+    /// @tparam C char or wchar_t
+    /// @param src The buffer to search
+    /// @param needle The delimiter to locate
+    /// @param from The starting position
+    /// @return Position of the match or npos; identical to std::basic_string_view::find
+    template <typename C>
+    static constexpr std::size_t find(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from = 0) noexcept
+    {
+        if (std::is_constant_evaluated()) return internal_helpers::find_scalar(src, needle, from);
+        return find(src, needle, from, active_level());
+    }
+
+    /// @brief Count the non-overlapping occurrences of needle in src at or after from using the given instruction set.
+    ///        The level must not exceed supported_level().
+    template <typename C>
+    static std::size_t
+    count(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from, simd_level level) noexcept
+    {
+#if defined(SIDDIQSOFT_DELIMITER_SCAN_X86)
+        if (level == simd_level::avx2) return internal_helpers::count_avx2(src, needle, from);
+        if (level == simd_level::sse2) return internal_helpers::count_sse2(src, needle, from);
+#else
+        (void)level;
+#endif
+        return internal_helpers::count_scalar(src, needle, from);
+    }
+
+    /// @brief Count the non-overlapping occurrences of needle in src at or after from; the occurrences are those found
+    ///        by repeated calls to find which resume after the previous match. An empty needle counts zero.
+    ///        Uses the vectorized kernel selected at runtime; the constant-evaluated path is scalar.
+    /// @tparam C char or wchar_t
+    /// @param src The buffer to search
+    /// @param needle The delimiter to count
+    /// @param from The starting position
+    /// @return The number of occurrences
+    template <typename C>
+    static constexpr std::size_t
+    count(std::basic_string_view<C> src, std::basic_string_view<C> needle, std::size_t from = 0) noexcept
+    {
+        if (std::is_constant_evaluated()) return internal_helpers::count_scalar(src, needle, from);
+        return count(src, needle, from, active_level());
+    }
+
+
+    /// @brief Locate the first position at which either delimiter occurs using the given instruction set.
+    ///        The level must not exceed supported_level().
+    template <typename C>
+    static match find_either(std::basic_string_view<C> src,
+                             std::basic_string_view<C> first,
+                             std::size_t               firstFrom,
+                             std::basic_string_view<C> second,
+                             std::size_t               secondFrom,
+                             simd_level                level) noexcept
+    {
+        // An empty delimiter never matches; reduce to the single delimiter search.
+        if (first.empty() && second.empty()) return {};
+        if (first.empty() || second.empty())
+        {
+            const bool        useFirst = !first.empty();
+            const std::size_t pos      = find(src, useFirst ? first : second, useFirst ? firstFrom : secondFrom, level);
+            return pos == std::basic_string_view<C>::npos ? match {} : match {pos, useFirst ? 0u : 1u};
+        }
+#if defined(SIDDIQSOFT_DELIMITER_SCAN_X86)
+        if (level == simd_level::avx2) return internal_helpers::find_either_avx2(src, first, firstFrom, second, secondFrom);
+        if (level == simd_level::sse2) return internal_helpers::find_either_sse2(src, first, firstFrom, second, secondFrom);
+#endif
+        return internal_helpers::find_either_scalar(src, first, firstFrom, second, secondFrom);
+    }
+
+    /// @brief Locate the first position at which either delimiter occurs in a single forward pass.
+    ///        Each delimiter has its own starting position; when both match at the same position the first delimiter wins.
+    ///        An empty delimiter never matches.
+    /// @tparam C char or wchar_t
+    /// @param src The buffer to search
+    /// @param first The first (preferred) delimiter
+    /// @param firstFrom The position from which the first delimiter may match
+    /// @param second The second delimiter
+    /// @param secondFrom The position from which the second delimiter may match
+    /// @return The earliest match and which delimiter matched
+    template <typename C>
+    static constexpr match find_either(std::basic_string_view<C> src,
+                                       std::basic_string_view<C> first,
+                                       std::size_t               firstFrom,
+                                       std::basic_string_view<C> second,
+                                       std::size_t               secondFrom) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            if (first.empty() && second.empty()) return {};
+            if (first.empty() || second.empty())
+            {
+                const bool        useFirst = !first.empty();
+                const std::size_t pos = internal_helpers::find_scalar(src, useFirst ? first : second, useFirst ? firstFrom : secondFrom);
+                return pos == std::basic_string_view<C>::npos ? match {} : match {pos, useFirst ? 0u : 1u};
+            }
+            return internal_helpers::find_either_scalar(src, first, firstFrom, second, secondFrom);
+        }
+        return find_either(src, first, firstFrom, second, secondFrom, active_level());
+    }
+
+
+    /// @brief Locate the first element of src at or after from which is a member of the delimiter set using the given
+    ///        instruction set. The level must not exceed supported_level().
+    /// @return Position of the element or npos; identical to std::basic_string_view::find_first_of
+    template <typename C>
+    static std::size_t find_first_of(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from, simd_level level) noexcept
+    {
+        return internal_helpers::find_in_set<true>(src, set, from, level);
+    }
+
+    /// @brief Locate the first element of src at or after from which is a member of the delimiter set.
+    ///        Uses the vectorized kernel selected at runtime; the constant-evaluated path is scalar.
+    /// @tparam C char or wchar_t
+    /// @param src The buffer to search
+    /// @param set The delimiters
+    /// @param from The starting position
+    /// @return Position of the element or npos; identical to std::basic_string_view::find_first_of
+    template <typename C>
+    static constexpr std::size_t find_first_of(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from = 0) noexcept
+    {
+        if (std::is_constant_evaluated()) return internal_helpers::find_in_set_scalar<true>(src, set, from);
+        return internal_helpers::find_in_set<true>(src, set, from, active_level());
+    }
+
+    /// @brief Locate the first element of src at or after from which is not a member of the delimiter set using the
+    ///        given instruction set. The level must not exceed supported_level().
+    /// @return Position of the element or npos; identical to std::basic_string_view::find_first_not_of
+    template <typename C>
+    static std::size_t
+    find_first_not_of(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from, simd_level level) noexcept
+    {
+        return internal_helpers::find_in_set<false>(src, set, from, level);
+    }
+
+    /// @brief Locate the first element of src at or after from which is not a member of the delimiter set.
+    ///        Uses the vectorized kernel selected at runtime; the constant-evaluated path is scalar.
+    /// @return Position of the element or npos; identical to std::basic_string_view::find_first_not_of
+    template <typename C>
+    static constexpr std::size_t find_first_not_of(std::basic_string_view<C> src, const delimiter_set<C>& set, std::size_t from = 0) noexcept
+    {
+        if (std::is_constant_evaluated()) return internal_helpers::find_in_set_scalar<false>(src, set, from);
+        return internal_helpers::find_in_set<false>(src, set, from, active_level());
+    }
+
+
+    /// @brief View of a compile-time delimiter in the character type C of the source. The delimiters are expected to be
+    ///        ASCII so a narrow literal may be used with a wide source.
+    template <typename C, auto S> constexpr std::basic_string_view<C> fixed_view() noexcept
+    {
+        return {internal_helpers::fixed_storage<C, S>::value.data(), S.size()};
+    }
+
+    /// @brief Locate the first occurrence of the compile-time needle in src at or after from.
+    ///        The kernel is selected at compile time from the length of the needle: a single element delimiter (such as
+    ///        "=" or "&") uses memchr/wmemchr, a two element delimiter (such as "\r\n" or ": ") locates the first element
+    ///        with memchr/wmemchr and checks the second directly and longer delimiters use the vectorized find.
+    /// @tparam Needle The delimiter as a fixed_string
+    /// @return Position of the match or npos; identical to std::basic_string_view::find
+    template <fixed_string Needle, typename C>
+    static constexpr std::size_t find_fixed(std::basic_string_view<C> src, std::size_t from = 0) noexcept
+    {
+        constexpr auto needle = fixed_view<C, Needle>();
+
+        if constexpr (needle.empty())
+        {
+            // As with std::basic_string_view::find an empty needle matches at from
+            return (from <= src.size()) ? from : std::basic_string_view<C>::npos;
+        }
+        else
+        {
+            if (std::is_constant_evaluated() || from >= src.size()) return internal_helpers::find_scalar(src, needle, from);
+
+            if constexpr (needle.size() == 1)
+            {
+                const C* p = std::char_traits<C>::find(src.data() + from, src.size() - from, needle[0]);
+                return (p == nullptr) ? std::basic_string_view<C>::npos : static_cast<std::size_t>(p - src.data());
+            }
+            else if constexpr (needle.size() == 2)
+            {
+                const C*          s = src.data();
+                const std::size_t n = src.size();
+                // The first element may only match at n - 2 or earlier.
+                for (std::size_t i = from; i + 1 < n; ++i)
+                {
+                    const C* p = std::char_traits<C>::find(s + i, n - 1 - i, needle[0]);
+                    if (p == nullptr) break;
+                    i = static_cast<std::size_t>(p - s);
+                    if (s[i + 1] == needle[1]) return i;
+                }
+                return std::basic_string_view<C>::npos;
+            }
+            else
+            {
+                return find(src, needle, from);
+            }
+        }
+    }
+
+    /// @brief Locate the first position at which either compile-time delimiter occurs; same contract as find_either.
+    ///        When the first delimiter begins with the second (for example "\r\n\r\n" and "\r\n") every occurrence of the
+    ///        first is also an occurrence of the second so a single scan for the second locates both.
+    /// @tparam First The first (preferred) delimiter
+    /// @tparam Second The second delimiter
+    template <fixed_string First, fixed_string Second, typename C>
+    static constexpr match find_either_fixed(std::basic_string_view<C> src, std::size_t firstFrom, std::size_t secondFrom) noexcept
+    {
+        constexpr auto first  = fixed_view<C, First>();
+        constexpr auto second = fixed_view<C, Second>();
+        constexpr auto npos   = std::basic_string_view<C>::npos;
+
+        if constexpr (first.empty() && second.empty())
+        {
+            return {};
+        }
+        else if constexpr (first.empty())
+        {
+            const auto pos = find_fixed<Second>(src, secondFrom);
+            return pos == npos ? match {} : match {pos, 1u};
+        }
+        else if constexpr (second.empty())
+        {
+            const auto pos = find_fixed<First>(src, firstFrom);
+            return pos == npos ? match {} : match {pos, 0u};
+        }
+        else if constexpr (first.starts_with(second))
+        {
+            std::size_t from = (firstFrom < secondFrom) ? firstFrom : secondFrom;
+            while ((from = find_fixed<Second>(src, from)) != npos)
+            {
+                if (from >= firstFrom && src.substr(from).starts_with(first)) return {from, 0u};
+                if (from >= secondFrom) return {from, 1u};
+                ++from;
+            }
+            return {};
+        }
+        else
+        {
+            return find_either(src, first, firstFrom, second, secondFrom);
+        }
+    }
+} // namespace siddiqsoft::delimiter_scan
@@ -0,0 +1,367 @@
+/*
+	Flat Header Map
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "case_insensitive.hpp"
+#include "well_known_headers.hpp"
+
+
+namespace siddiqsoft::string2map
+{
+    /// @brief Compact, cache-friendly container for a block of key-value pairs such as HTTP headers.
+    ///        The keys and values are stored back-to-back in a single backing string (the arena) and each element is a
+    ///        16-byte entry holding the hash of the key, its offset and the key and value lengths. The first N entries are
+    ///        stored inline; only larger blocks spill to the heap. Lookup is a linear scan of the entries comparing the
+    ///        stored hash before the key, which beats node based containers for the typical 10-30 headers.
+    ///        Duplicate keys are preserved in insertion order (find returns the first). With the case_insensitive policy
+    ///        the stored hash is of the case-folded key so lookups need no lowercase copy of either side.
+    ///        Since entries are offsets into the arena the container may be copied and moved freely; the views returned
+    ///        remain valid until the next modification.
+    ///        With a KnownKeys table (well_known_headers) each key is looked up in its perfect hash as it is added: a key
+    ///        in the canonical spelling is not copied to the arena (the entry refers to the static name) and the first
+    ///        occurrence of every known key is indexed so get(id) is O(1).
+    /// @tparam C Character type (char or wchar_t)
+    /// @tparam N Number of entries stored inline
+    /// @tparam KeyPolicy case_sensitive (default) or case_insensitive
+    /// @tparam KnownKeys no_known_keys (default) or well_known_headers
+    template <typename C = char, size_t N = 32, typename KeyPolicy = case_sensitive, typename KnownKeys = no_known_keys>
+    class flat_header_map
+    {
+    public:
+        using char_type   = C;
+        using string_type = std::basic_string<C>;
+        using view_type   = std::basic_string_view<C>;
+        using key_type    = view_type;
+        using mapped_type = view_type;
+        using value_type  = std::pair<view_type, view_type>;
+        using size_type   = size_t;
+        using key_policy  = KeyPolicy;
+        using known_keys  = KnownKeys;
+        using id_type     = typename KnownKeys::id_type;
+
+        static constexpr size_type inline_capacity = N;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = flat_header_map::value_type;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = value_type;
+
+            const_iterator() = default;
+
+            value_type operator*() const { return owner_->element(index_); }
+            value_type operator[](difference_type n) const { return owner_->element(index_ + n); }
+
+            const_iterator& operator++()
+            {
+                ++index_;
+                return *this;
+            }
+            const_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++index_;
+                return tmp;
+            }
+            const_iterator& operator--()
+            {
+                --index_;
+                return *this;
+            }
+            const_iterator operator--(int)
+            {
+                auto tmp = *this;
+                --index_;
+                return tmp;
+            }
+            const_iterator& operator+=(difference_type n)
+            {
+                index_ += n;
+                return *this;
+            }
+            const_iterator& operator-=(difference_type n)
+            {
+                index_ -= n;
+                return *this;
+            }
+            friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+            friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+            friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const const_iterator& a, const const_iterator& b)
+            {
+                return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+            }
+            friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.index_ == b.index_; }
+            friend auto operator<=>(const const_iterator& a, const const_iterator& b) { return a.index_ <=> b.index_; }
+
+        private:
+            friend class flat_header_map;
+
+            const_iterator(const flat_header_map* owner, size_type index)
+                : owner_(owner)
+                , index_(index)
+            {
+            }
+
+            const flat_header_map* owner_ {nullptr};
+            size_type              index_ {0};
+        };
+
+        using iterator = const_iterator;
+
+        flat_header_map() = default;
+
+        /// @brief FNV-1a hash of the key (folded by the key policy); stored with each entry so lookups compare the key only
+        ///        on a hash match.
+        static constexpr std::uint32_t hash(view_type key) noexcept { return key_hash<KeyPolicy>(key); }
+
+        /// @brief Reserve room for the given number of pairs and elements of key and value text.
+        void reserve(size_type pairs, size_type elements)
+        {
+            if (pairs > N) spill_.reserve(pairs - N);
+            arena_.reserve(elements);
+        }
+
+        /// @brief Remove all elements keeping the arena and spill capacity for reuse.
+        void clear() noexcept
+        {
+            size_ = 0;
+            spill_.clear();
+            arena_.clear();
+            first_.fill(0);
+        }
+
+        /// @brief Append the key-value pair; duplicates are kept.
+        /// @return Iterator to the new element
+        iterator emplace(view_type key, view_type value)
+        {
+            return emplace_with(key, value.size(), [value](string_type& arena) { arena.append(value); });
+        }
+
+        /// @brief Append the key and a value which the callable writes straight into the arena (a value unfolded or
+        ///        decoded from its source) so no intermediate string is built; duplicates are kept.
+        /// @param valueBound The most elements appendValue appends
+        /// @param appendValue Callable with signature void(string_type&) appending the value to the string it is given
+        /// @return Iterator to the new element
+        template <typename F> iterator emplace_with(view_type key, size_type valueBound, F&& appendValue)
+        {
+            // The top bit of the key length marks an interned key
+            if (key.size() >= interned_key) throw std::length_error("flat_header_map key exceeds 2GB");
+            if (arena_.size() + key.size() + valueBound > UINT32_MAX) throw std::length_error("flat_header_map arena exceeds 4GB");
+
+            entry e {0, static_cast<std::uint32_t>(arena_.size()), static_cast<std::uint32_t>(key.size()), 0};
+
+            if (!recognize(e, key)) e.hash = hash(key);
+            if (!interned(e)) arena_.append(key);
+            const auto valueAt = arena_.size();
+            appendValue(arena_);
+            e.valueLength = static_cast<std::uint32_t>(arena_.size() - valueAt);
+            if (size_ < N)
+                inline_[size_] = e;
+            else
+                spill_.push_back(e);
+            return {this, size_++};
+        }
+
+        /// @return Iterator to the first element with the given key or end()
+        iterator find(view_type key) const noexcept
+        {
+            const auto h = hash(key);
+            for (size_type i = 0; i < size_; ++i)
+            {
+                if (matches(entry_at(i), h, key)) return {this, i};
+            }
+            return end();
+        }
+
+        bool contains(view_type key) const noexcept { return find(key) != end(); }
+
+        /// @return Iterator to the first element with the well-known key or end(); O(1)
+        iterator find(id_type id) const noexcept
+            requires(KnownKeys::count > 0)
+        {
+            const auto first = first_[static_cast<size_t>(id)];
+            return (first == 0) ? end() : iterator {this, first - 1};
+        }
+
+        bool contains(id_type id) const noexcept
+            requires(KnownKeys::count > 0)
+        {
+            return first_[static_cast<size_t>(id)] != 0;
+        }
+
+        /// @return The value of the first element with the well-known key or std::nullopt; O(1)
+        std::optional<view_type> get(id_type id) const noexcept
+            requires(KnownKeys::count > 0)
+        {
+            if (auto it = find(id); it != end()) return (*it).second;
+            return std::nullopt;
+        }
+
+        /// @return Number of elements with the given key
+        size_type count(view_type key) const noexcept
+        {
+            const auto h = hash(key);
+            size_type  n = 0;
+            for (size_type i = 0; i < size_; ++i)
+                n += matches(entry_at(i), h, key) ? 1 : 0;
+            return n;
+        }
+
+        /// @return The value of the first element with the given key
+        /// @throws std::out_of_range if the key is not present
+        view_type at(view_type key) const
+        {
+            if (auto it = find(key); it != end()) return (*it).second;
+            throw std::out_of_range("flat_header_map::at key not found");
+        }
+
+        iterator  begin() const noexcept { return {this, 0}; }
+        iterator  end() const noexcept { return {this, size_}; }
+        size_type size() const noexcept { return size_; }
+        bool      empty() const noexcept { return size_ == 0; }
+
+        /// @brief The backing string holding every key and value back-to-back.
+        const string_type& arena() const noexcept { return arena_; }
+
+        /// @brief Element-wise comparison (same pairs in the same order).
+        friend bool operator==(const flat_header_map& a, const flat_header_map& b)
+        {
+            if (a.size_ != b.size_) return false;
+            for (size_type i = 0; i < a.size_; ++i)
+            {
+                if (a.element(i) != b.element(i)) return false;
+            }
+            return true;
+        }
+
+    private:
+        struct entry
+        {
+            std::uint32_t hash;
+            std::uint32_t offset;
+            std::uint32_t keyLength;
+            std::uint32_t valueLength;
+        };
+
+        /// @brief Set in entry::keyLength (with the index of the name in the low bits) for a key referring to the static
+        ///        name of KnownKeys; the arena then holds only the value. emplace rejects a key this long so a copied key
+        ///        never sets it.
+        static constexpr std::uint32_t interned_key = 0x80000000u;
+
+        const entry& entry_at(size_type i) const noexcept { return (i < N) ? inline_[i] : spill_[i - N]; }
+
+        /// @brief Look the key up in KnownKeys: a known key takes the precomputed hash of its name, its first occurrence is
+        ///        indexed for get(id) and, in the canonical spelling, the entry refers to the static name.
+        /// @return false if the key is not known
+        bool recognize(entry& e, view_type key) noexcept
+        {
+            if constexpr (KnownKeys::count > 0)
+            {
+                const auto id = KnownKeys::template lookup<KeyPolicy>(key);
+                if (id == KnownKeys::count) return false;
+
+                e.hash = KnownKeys::template hash<KeyPolicy>(id);
+                if (first_[id] == 0) first_[id] = static_cast<std::uint32_t>(size_ + 1);
+                // A case-sensitive match is the canonical spelling
+                if (std::is_same_v<KeyPolicy, case_sensitive> || key == KnownKeys::template name<C>(id))
+                    e.keyLength = interned_key | static_cast<std::uint32_t>(id);
+                return true;
+            }
+            else
+            {
+                (void)e;
+                (void)key;
+                return false;
+            }
+        }
+
+        bool interned(const entry& e) const noexcept
+        {
+            if constexpr (KnownKeys::count > 0)
+                return (e.keyLength & interned_key) != 0;
+            else
+                return false;
+        }
+
+        /// @return The key and the arena offset of the value
+        std::pair<view_type, size_type> key_of(const entry& e) const noexcept
+        {
+            if (interned(e)) return {KnownKeys::template name<C>(e.keyLength & ~interned_key), e.offset};
+            return {view_type {arena_}.substr(e.offset, e.keyLength), e.offset + e.keyLength};
+        }
+
+        bool matches(const entry& e, std::uint32_t h, view_type key) const noexcept
+        {
+            if (e.hash != h) return false;
+            const auto stored = key_of(e).first;
+            return stored.size() == key.size() && KeyPolicy::equal(stored, key);
+        }
+
+        value_type element(size_type i) const noexcept
+        {
+            const auto& e              = entry_at(i);
+            const auto [key, valueAt] = key_of(e);
+            return {key, view_type {arena_}.substr(valueAt, e.valueLength)};
+        }
+
+        std::array<entry, N> inline_ {};
+        std::vector<entry>   spill_ {};
+        string_type          arena_ {};
+        size_type            size_ {0};
+        // One more than the index of the first element with each known key (0 when absent)
+        std::array<std::uint32_t, KnownKeys::count> first_ {};
+    };
+} // namespace siddiqsoft::string2map
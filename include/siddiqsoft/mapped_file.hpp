@@ -0,0 +1,466 @@
+/*
+	Memory Mapped File Parse Helpers
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "string2map.hpp"
+#include "string2vector.hpp"
+
+
+namespace siddiqsoft
+{
+    /// @brief A file mapped read-only into memory (mmap on POSIX, a file mapping view on Windows) so that it may be
+    ///        parsed in place without reading it into a string. Pages are loaded on demand as they are scanned.
+    class mapped_file
+    {
+    public:
+        /// @brief Map the file.
+        /// @param path The file to map; an empty file is valid and yields an empty view
+        /// @throws std::system_error if the file cannot be opened or mapped
+        explicit mapped_file(const std::filesystem::path& path)
+        {
+#if defined(_WIN32)
+            HANDLE file = ::CreateFileW(path.c_str(),
+                                        GENERIC_READ,
+                                        FILE_SHARE_READ,
+                                        nullptr,
+                                        OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                        nullptr);
+            if (file == INVALID_HANDLE_VALUE) fail(static_cast<int>(::GetLastError()), std::system_category(), "mapped_file: open ", path);
+
+            LARGE_INTEGER length {};
+            if (!::GetFileSizeEx(file, &length))
+            {
+                const auto error = static_cast<int>(::GetLastError());
+                ::CloseHandle(file);
+                fail(error, std::system_category(), "mapped_file: size ", path);
+            }
+
+            if (length.QuadPart > 0)
+            {
+                HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping == nullptr)
+                {
+                    const auto error = static_cast<int>(::GetLastError());
+                    ::CloseHandle(file);
+                    fail(error, std::system_category(), "mapped_file: map ", path);
+                }
+
+                data_            = static_cast<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                const auto error = static_cast<int>(::GetLastError());
+                // The view keeps the mapping (and the file) open.
+                ::CloseHandle(mapping);
+                if (data_ == nullptr)
+                {
+                    ::CloseHandle(file);
+                    fail(error, std::system_category(), "mapped_file: map ", path);
+                }
+                size_ = static_cast<std::size_t>(length.QuadPart);
+            }
+            ::CloseHandle(file);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd == -1) fail(errno, std::generic_category(), "mapped_file: open ", path);
+
+            struct stat info {};
+            if (::fstat(fd, &info) == -1)
+            {
+                const int error = errno;
+                ::close(fd);
+                fail(error, std::generic_category(), "mapped_file: stat ", path);
+            }
+
+            if (info.st_size > 0)
+            {
+                void* address = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address == MAP_FAILED)
+                {
+                    const int error = errno;
+                    ::close(fd);
+                    fail(error, std::generic_category(), "mapped_file: mmap ", path);
+                }
+                // The mapping is scanned front to back.
+                ::madvise(address, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(address);
+                size_ = static_cast<std::size_t>(info.st_size);
+            }
+            // The mapping remains valid once the descriptor is closed.
+            ::close(fd);
+#endif
+        }
+
+        mapped_file(const mapped_file&)            = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr))
+            , size_(std::exchange(other.size_, 0))
+        {
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        ~mapped_file() { unmap(); }
+
+        const char* data() const noexcept { return data_; }
+
+        std::size_t size() const noexcept { return size_; }
+
+        bool empty() const noexcept { return size_ == 0; }
+
+        /// @brief The contents of the file; valid for the lifetime of this object.
+        std::string_view view() const noexcept { return {data_, size_}; }
+
+        /// @brief Tell the OS that the pages before upTo are no longer needed so they can be dropped from memory (they
+        ///        remain readable and are reloaded from the file if touched again). Used by the streaming functions to
+        ///        keep the resident size flat regardless of the size of the file.
+        void release(std::size_t upTo) const noexcept
+        {
+            if (data_ == nullptr) return;
+            if (upTo > size_) upTo = size_;
+#if defined(_WIN32)
+            SYSTEM_INFO system {};
+            ::GetSystemInfo(&system);
+            const std::size_t length = upTo - (upTo % system.dwPageSize);
+            // Unlocking pages which are not locked removes them from the working set.
+            if (length > 0) ::VirtualUnlock(const_cast<char*>(data_), length);
+#else
+            const auto        page   = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t length = upTo - (upTo % page);
+            if (length > 0) ::madvise(const_cast<char*>(data_), length, MADV_DONTNEED);
+#endif
+        }
+
+    private:
+        void unmap() noexcept
+        {
+            if (data_ == nullptr) return;
+#if defined(_WIN32)
+            ::UnmapViewOfFile(data_);
+#else
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        [[noreturn]] static void fail(int error, const std::error_category& category, const char* what, const std::filesystem::path& path)
+        {
+            throw std::system_error(error, category, what + path.string());
+        }
+
+        const char* data_ {nullptr};
+        std::size_t size_ {0};
+    };
+
+
+    /// @brief A zero-copy parse result together with the mapping its views refer to. Moving or copying the result keeps
+    ///        the mapping alive (it is released with the last copy).
+    /// @tparam R The container of views
+    template <typename R> class mapped_result
+    {
+    public:
+        mapped_result(std::shared_ptr<const mapped_file> file, R value, std::size_t consumed)
+            : file_(std::move(file))
+            , value_(std::move(value))
+            , consumed_(consumed)
+        {
+        }
+
+        const R& operator*() const noexcept { return value_; }
+
+        R& operator*() noexcept { return value_; }
+
+        const R* operator->() const noexcept { return &value_; }
+
+        R* operator->() noexcept { return &value_; }
+
+        /// @brief Number of elements of the file consumed
+        std::size_t consumed() const noexcept { return consumed_; }
+
+        const mapped_file& file() const noexcept { return *file_; }
+
+    private:
+        std::shared_ptr<const mapped_file> file_ {};
+        R                                  value_ {};
+        std::size_t                        consumed_ {0};
+    };
+
+
+    namespace internal_helpers
+    {
+        /// @brief The streaming functions release the pages behind them every this many bytes.
+        inline constexpr std::size_t release_interval = 16 * 1024 * 1024;
+
+        /// @brief Invoke the visitor; one returning bool may return false to stop.
+        template <typename F, typename... Args> bool visit(F& visitor, Args&&... args)
+        {
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, Args...>, bool>)
+                return visitor(std::forward<Args>(args)...);
+            else
+            {
+                visitor(std::forward<Args>(args)...);
+                return true;
+            }
+        }
+    } // namespace internal_helpers
+} // namespace siddiqsoft
+
+
+namespace siddiqsoft::string2map
+{
+    /// @brief Parse a file containing key-value pairs into a map without reading it into a string: the file is mapped
+    ///        read-only and parsed in place so only the resulting container is allocated.
+    /// @tparam D Destination type: std::string or std::wstring (the file is read as UTF-8). Defaults to std::string.
+    /// @tparam R Defaults to std::map; std::multimap, std::unordered_map and flat_header_map are also supported
+    /// @param path The file to parse
+    /// @param keyDelimiter Delimiter for the key portion. Example: "=" or ": "
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param consumed Receives the number of bytes of the file consumed
+    /// @return map of key-value elements of given type
+    /// @throws std::system_error if the file cannot be mapped
+    template <typename D = std::string, typename R = std::map<D, D>>
+    static R parse_file(const std::filesystem::path& path,
+                        const std::string&           keyDelimiter,
+                        const std::string&           valueDelimiter,
+                        const std::string&           terminalDelimiter,
+                        size_t&                      consumed) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<std::string, D, R>)
+        {
+            const mapped_file file {path};
+
+            R resultMap {};
+            consumed = for_each_pair(file.view(),
+                                     std::string_view {keyDelimiter},
+                                     std::string_view {valueDelimiter},
+                                     std::string_view {terminalDelimiter},
+                                     [&](std::string_view key, std::string_view value) { internal_helpers::insert_pair<D>(resultMap, key, value); });
+            return resultMap;
+        }
+
+        throw std::runtime_error("parse_file() destination must be string or wstring");
+    }
+
+
+    /// @brief Parse a file containing key-value pairs into a map; see parse_file.
+    /// @return map of key-value elements of given type
+    template <typename D = std::string, typename R = std::map<D, D>>
+    static R parse_file(const std::filesystem::path& path,
+                        const std::string&           keyDelimiter,
+                        const std::string&           valueDelimiter,
+                        const std::string&           terminalDelimiter = {}) noexcept(false)
+    {
+        size_t consumed {};
+        return parse_file<D, R>(path, keyDelimiter, valueDelimiter, terminalDelimiter, consumed);
+    }
+
+
+    /// @brief Zero-copy variant of parse_file: the key-value pairs are views into the mapped file which is kept alive by
+    ///        the result.
+    /// @tparam R Defaults to std::vector<std::pair<std::string_view, std::string_view>> (source order); std::map,
+    ///           std::multimap or std::unordered_map of std::string_view may also be used
+    /// @param path The file to parse
+    /// @param keyDelimiter Delimiter for the key portion. Example: "=" or ": "
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @return The container (via * or ->) along with the mapping and the number of bytes consumed
+    /// @throws std::system_error if the file cannot be mapped
+    template <typename R = std::vector<std::pair<std::string_view, std::string_view>>>
+    static mapped_result<R> parse_file_view(const std::filesystem::path& path,
+                                            const std::string&           keyDelimiter,
+                                            const std::string&           valueDelimiter,
+                                            const std::string&           terminalDelimiter = {}) noexcept(false)
+    {
+        auto   file = std::make_shared<const mapped_file>(path);
+        size_t consumed {};
+        auto   pairs = parse_view<std::string_view, R>(
+                file->view(), std::string_view {keyDelimiter}, std::string_view {valueDelimiter}, std::string_view {terminalDelimiter}, consumed);
+        return {std::move(file), std::move(pairs), consumed};
+    }
+
+
+    /// @brief Stream the key-value pairs of a file to the visitor without building a container (see for_each_pair). The
+    ///        pages of the mapping behind the scan are released as it proceeds so the memory used stays flat no matter
+    ///        how large the file is. The views passed to the visitor are only valid until it returns.
+    /// @tparam F Callable with signature void(std::string_view, std::string_view) or bool(...) returning false to stop
+    /// @param path The file to parse
+    /// @param keyDelimiter Delimiter for the key portion. Example: "=" or ": "
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param visitor Invoked for each key-value pair in file order
+    /// @return Number of bytes of the file consumed
+    /// @throws std::system_error if the file cannot be mapped
+    template <typename F>
+    static size_t for_each_pair_in_file(const std::filesystem::path& path,
+                                        const std::string&           keyDelimiter,
+                                        const std::string&           valueDelimiter,
+                                        const std::string&           terminalDelimiter,
+                                        F&&                          visitor) noexcept(false)
+    {
+        const mapped_file file {path};
+        size_t            released = 0;
+
+        return for_each_pair(file.view(),
+                             std::string_view {keyDelimiter},
+                             std::string_view {valueDelimiter},
+                             std::string_view {terminalDelimiter},
+                             [&](std::string_view key, std::string_view value) {
+                                 // Everything before this element has been delivered.
+                                 const auto position = static_cast<size_t>(key.data() - file.data());
+                                 if (position - released >= siddiqsoft::internal_helpers::release_interval)
+                                 {
+                                     file.release(position);
+                                     released = position;
+                                 }
+                                 return siddiqsoft::internal_helpers::visit(visitor, key, value);
+                             });
+    }
+} // namespace siddiqsoft::string2map
+
+
+namespace siddiqsoft::string2vector
+{
+    /// @brief Splits a file yielding a vector of substrings without reading it into a string: the file is mapped
+    ///        read-only and split in place (same semantics as parse).
+    /// @param path The file to split
+    /// @param delimiters The delimiters
+    /// @return A vector of the tokens
+    /// @throws std::system_error if the file cannot be mapped
+    inline std::vector<std::string> parse_file(const std::filesystem::path& path, const std::string& delimiters) noexcept(false)
+    {
+        const mapped_file file {path};
+
+        std::vector<std::string> tokens;
+        for (auto token : split_view<char> {file.view(), delimiters})
+            tokens.emplace_back(token);
+        return tokens;
+    }
+
+
+    /// @brief Zero-copy variant of parse_file: the tokens are views into the mapped file which is kept alive by the result.
+    /// @param path The file to split
+    /// @param delimiters The delimiters
+    /// @return The vector of tokens (via * or ->) along with the mapping; consumed is the size of the file
+    /// @throws std::system_error if the file cannot be mapped
+    inline mapped_result<std::vector<std::string_view>> parse_file_view(const std::filesystem::path& path,
+                                                                        const std::string&           delimiters) noexcept(false)
+    {
+        auto file = std::make_shared<const mapped_file>(path);
+
+        std::vector<std::string_view> tokens;
+        for (auto token : split_view<char> {file->view(), delimiters})
+            tokens.push_back(token);
+
+        const auto size = file->size();
+        return {std::move(file), std::move(tokens), size};
+    }
+
+
+    /// @brief Stream the tokens of a file to the visitor without building a container. The pages of the mapping behind
+    ///        the scan are released as it proceeds so the memory used stays flat no matter how large the file is. The
+    ///        views passed to the visitor are only valid until it returns.
+    /// @tparam F Callable with signature void(std::string_view) or bool(std::string_view) returning false to stop
+    /// @param path The file to split
+    /// @param delimiters The delimiters
+    /// @param visitor Invoked for each token in file order
+    /// @return Number of tokens delivered to the visitor
+    /// @throws std::system_error if the file cannot be mapped
+    template <typename F>
+    static size_t for_each_token_in_file(const std::filesystem::path& path, const std::string& delimiters, F&& visitor) noexcept(false)
+    {
+        const mapped_file file {path};
+        size_t            released = 0;
+        size_t            count    = 0;
+
+        for (auto token : split_view<char> {file.view(), delimiters})
+        {
+            const auto position = static_cast<size_t>(token.data() - file.data());
+            if (position - released >= siddiqsoft::internal_helpers::release_interval)
+            {
+                file.release(position);
+                released = position;
+            }
+
+            ++count;
+            if (!siddiqsoft::internal_helpers::visit(visitor, token)) break;
+        }
+        return count;
+    }
+} // namespace siddiqsoft::string2vector
@@ -0,0 +1,350 @@
+/*
+	Parallel Parse Helpers
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "delimiter_scan.hpp"
+#include "string2map.hpp"
+#include "string2vector.hpp"
+
+
+namespace siddiqsoft::parallel_parse
+{
+    /// @brief Tuning for the parallel parse functions.
+    struct options
+    {
+        /// @brief Number of threads (including the calling thread); 0 selects std::thread::hardware_concurrency()
+        unsigned threads {0};
+        /// @brief Minimum number of elements of the source per chunk; smaller inputs are parsed serially
+        std::size_t min_chunk {256 * 1024};
+    };
+
+    namespace internal_helpers
+    {
+        /// @brief Nominal chunk boundaries: the source is divided evenly among the threads subject to the minimum chunk size.
+        /// @return The start of each chunk (the first is always 0); a single element means the parse should be serial
+        inline std::vector<std::size_t> nominal_boundaries(std::size_t length, const options& opts)
+        {
+            std::size_t threads = (opts.threads != 0) ? opts.threads : std::thread::hardware_concurrency();
+            const auto  chunk   = (opts.min_chunk != 0) ? opts.min_chunk : 1;
+            if (threads == 0) threads = 1;
+            if (length / chunk < threads) threads = (length / chunk > 0) ? length / chunk : 1;
+
+            std::vector<std::size_t> boundaries {};
+            boundaries.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i)
+                boundaries.push_back(length / threads * i);
+            return boundaries;
+        }
+
+        /// @brief Run work(i) for each chunk: chunk 0 on the calling thread and the others on their own threads.
+        ///        The first exception thrown by any chunk is rethrown once every thread has finished.
+        template <typename F> void run_chunks(std::size_t count, F&& work)
+        {
+            std::vector<std::exception_ptr> errors(count);
+            {
+                std::vector<std::jthread> workers {};
+                workers.reserve(count);
+                for (std::size_t i = 1; i < count; ++i)
+                {
+                    workers.emplace_back([&work, &errors, i] {
+                        try
+                        {
+                            work(i);
+                        }
+                        catch (...)
+                        {
+                            errors[i] = std::current_exception();
+                        }
+                    });
+                }
+
+                try
+                {
+                    work(0);
+                }
+                catch (...)
+                {
+                    errors[0] = std::current_exception();
+                }
+            }
+
+            for (auto& error : errors)
+            {
+                if (error) std::rethrow_exception(error);
+            }
+        }
+    } // namespace internal_helpers
+} // namespace siddiqsoft::parallel_parse
+
+
+namespace siddiqsoft::string2vector
+{
+    /// @brief Splits a given string yielding a vector of substrings, scanning chunks of the source on multiple threads.
+    ///        Each chunk boundary is moved forward to the next delimiter so no token straddles two chunks and the
+    ///        tokens of the chunks are concatenated in source order: the result is identical to parse.
+    /// @tparam T std::string or std::wstring
+    /// @param str The source string
+    /// @param delimiters The delimiters
+    /// @param options Thread count and minimum chunk size
+    /// @return A vector of type T
+    template <class T>
+    static std::vector<T> parse_parallel(const T& str, const T& delimiters, const parallel_parse::options& options = {})
+    {
+        using char_t = typename T::value_type;
+        using view_t = std::basic_string_view<char_t>;
+
+        const view_t src {str};
+        auto         starts = parallel_parse::internal_helpers::nominal_boundaries(src.size(), options);
+        if (starts.size() < 2) return parse(str, delimiters);
+
+        // A chunk may only begin at a delimiter (or the end of the source).
+        const delimiter_scan::delimiter_set<char_t> set {view_t {delimiters}};
+        for (std::size_t i = 1; i < starts.size(); ++i)
+        {
+            const auto pos = delimiter_scan::find_first_of(src, set, starts[i] > starts[i - 1] ? starts[i] : starts[i - 1]);
+            starts[i]      = (pos == view_t::npos) ? src.size() : pos;
+        }
+        starts.push_back(src.size());
+
+        std::vector<std::vector<T>> parts(starts.size() - 1);
+        parallel_parse::internal_helpers::run_chunks(parts.size(), [&](std::size_t i) {
+            for (auto token : split_view<char_t> {src.substr(starts[i], starts[i + 1] - starts[i]), view_t {delimiters}})
+                parts[i].emplace_back(token);
+        });
+
+        std::size_t total = 0;
+        for (const auto& part : parts)
+            total += part.size();
+
+        std::vector<T> tokens;
+        tokens.reserve(total);
+        for (auto& part : parts)
+            std::move(part.begin(), part.end(), std::back_inserter(tokens));
+        return tokens;
+    }
+} // namespace siddiqsoft::string2vector
+
+
+namespace siddiqsoft::string2map
+{
+    namespace internal_helpers
+    {
+        /// @brief Where the scan of one chunk of a parallel parse stopped.
+        struct chunk_end
+        {
+            /// @brief The start of the next element, or the number of elements consumed when final
+            size_t position {0};
+            /// @brief The scan reached the terminal delimiter, malformed input or the end of the source
+            bool final {false};
+        };
+
+        /// @brief Parse the elements of src which begin at or after from and before limit into the container. from must
+        ///        be the start of an element for the result to match the serial parse.
+        /// @param terminalSeen The lowest position at which any chunk has found the terminal delimiter (npos if none). A
+        ///                     chunk which finds it lowers the value; a chunk which begins beyond it stops as it cannot
+        ///                     contribute to the result.
+        template <typename D, typename R, typename C>
+        static chunk_end scan_chunk(R&                        resultMap,
+                                    std::basic_string_view<C> src,
+                                    std::basic_string_view<C> keyDelimiter,
+                                    std::basic_string_view<C> valueDelimiter,
+                                    std::basic_string_view<C> terminalDelimiter,
+                                    std::atomic<size_t>&      terminalSeen,
+                                    size_t                    from,
+                                    size_t                    limit)
+        {
+            // The serial scan searches for the terminal delimiter from just after the start of the previous value
+            // delimiter; one which begins inside that value delimiter ends the parse before this element.
+            if (!terminalDelimiter.empty() && from >= valueDelimiter.size())
+            {
+                for (size_t at = from - valueDelimiter.size() + 1; at < from; ++at)
+                {
+                    if (src.substr(at).starts_with(terminalDelimiter)) return {at + terminalDelimiter.size(), true};
+                }
+            }
+
+            pair_scanner<C> scanner {keyDelimiter, valueDelimiter, terminalDelimiter};
+            const auto      state = scanner.scan(src.substr(from), true, [&](std::basic_string_view<C> key, std::basic_string_view<C> value) {
+                if (from > terminalSeen.load(std::memory_order_relaxed)) return false;
+                insert_pair<D>(resultMap, key, value);
+                return static_cast<size_t>(value.data() + value.size() - src.data()) + valueDelimiter.size() < limit;
+            });
+
+            if (state == pair_scanner<C>::status::terminated)
+            {
+                const size_t at   = from + scanner.consumed() - terminalDelimiter.size();
+                size_t       seen = terminalSeen.load(std::memory_order_relaxed);
+                while (at < seen && !terminalSeen.compare_exchange_weak(seen, at, std::memory_order_relaxed))
+                    ;
+            }
+            return {from + scanner.consumed(), state != pair_scanner<C>::status::cancelled};
+        }
+
+        /// @brief Append the elements of a chunk to the result preserving the serial semantics: for unique keys the
+        ///        earlier element wins and equal keys of multi-containers keep their source order.
+        template <typename R> static void merge_into(R& resultMap, R& part)
+        {
+            if (resultMap.empty())
+                resultMap = std::move(part);
+            else if constexpr (requires { resultMap.merge(part); })
+                resultMap.merge(part);
+            else
+            {
+                for (auto&& [key, value] : part)
+                    resultMap.emplace(key, value);
+            }
+        }
+    } // namespace internal_helpers
+
+
+    /// @brief Given a string which contains a key-value pair, extract them into a map of the same type scanning chunks of
+    ///        the source on multiple threads. The result and consumed are identical to parse.
+    ///        Each chunk begins just after a value delimiter and every thread parses its chunk into its own container;
+    ///        the chunks are then merged in source order. The terminal delimiter is found by the chunk scans themselves
+    ///        (there is no serial search ahead of them) and the chunks beyond the first one found stop early. A chunk whose
+    ///        start turns out not to be the start of an element (for example a value delimiter inside a key) is parsed
+    ///        again from the correct position during the merge.
+    /// @tparam T Must be either std::string or std::wstring
+    /// @tparam D Destination type: if T is std::string then this may be std::wstring and vice-versa. Defaults to T.
+    /// @tparam R Defaults to std::map; std::multimap, std::unordered_map and flat_header_map are also supported
+    /// @param src The source string
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param consumed Receives the number of elements of src consumed
+    /// @param options Thread count and minimum chunk size
+    /// @return map of key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>>
+    static R parse_parallel(const T&                       src,
+                            const T&                       keyDelimiter,
+                            const T&                       valueDelimiter,
+                            const T&                       terminalDelimiter,
+                            size_t&                        consumed,
+                            const parallel_parse::options& options = {}) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<T, D, R>)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            const view_t source {src};
+            const view_t kd {keyDelimiter};
+            const view_t vd {valueDelimiter};
+            const view_t td {terminalDelimiter};
+
+            auto starts = parallel_parse::internal_helpers::nominal_boundaries(source.size(), options);
+            if (starts.size() < 2 || kd.empty() || vd.empty())
+                return parse<T, D, R>(src, keyDelimiter, valueDelimiter, terminalDelimiter, consumed);
+
+            // Each chunk begins just after a value delimiter.
+            size_t chunks = 1;
+            for (size_t i = 1; i < starts.size(); ++i)
+            {
+                const auto pos = delimiter_scan::find(source, vd, starts[i] > starts[chunks - 1] ? starts[i] : starts[chunks - 1]);
+                if (pos == view_t::npos || pos + vd.size() >= source.size()) break;
+                starts[chunks++] = pos + vd.size();
+            }
+            starts.resize(chunks);
+            starts.push_back(view_t::npos);
+
+            // Nothing beyond the first terminal delimiter is parsed.
+            std::atomic<size_t>                      terminalSeen {view_t::npos};
+            std::vector<R>                           parts(chunks);
+            std::vector<internal_helpers::chunk_end> ends(chunks);
+            parallel_parse::internal_helpers::run_chunks(chunks, [&](size_t i) {
+                ends[i] = internal_helpers::scan_chunk<D>(parts[i], source, kd, vd, td, terminalSeen, starts[i], starts[i + 1]);
+            });
+
+            // Merge in source order, re-parsing any chunk whose start was not reached by the preceding chunk.
+            R      resultMap {};
+            size_t position = 0;
+            for (size_t i = 0; i < chunks; ++i)
+            {
+                if (position >= starts[i + 1]) continue;
+
+                internal_helpers::chunk_end end {};
+                if (position == starts[i])
+                {
+                    internal_helpers::merge_into(resultMap, parts[i]);
+                    end = ends[i];
+                }
+                else
+                {
+                    end = internal_helpers::scan_chunk<D>(resultMap, source, kd, vd, td, terminalSeen, position, starts[i + 1]);
+                }
+
+                position = end.position;
+                if (end.final) break;
+            }
+
+            consumed = position;
+            return resultMap;
+        }
+
+        throw std::runtime_error("parse_parallel() src must be string or wstring");
+    }
+
+
+    /// @brief Given a string which contains a key-value pair, extract them into a map of the same type scanning chunks of
+    ///        the source on multiple threads; see parse_parallel.
+    /// @return map of key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>>
+    static R parse_parallel(const T&                       src,
+                            const T&                       keyDelimiter,
+                            const T&                       valueDelimiter,
+                            const T&                       terminalDelimiter = T {},
+                            const parallel_parse::options& options           = {}) noexcept(false)
+    {
+        size_t consumed {};
+        return parse_parallel<T, D, R>(src, keyDelimiter, valueDelimiter, terminalDelimiter, consumed, options);
+    }
+} // namespace siddiqsoft::string2map
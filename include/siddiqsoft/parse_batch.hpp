@@ -0,0 +1,713 @@
+/*
+	Batch Parse
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "case_insensitive.hpp"
+#include "parallel_parse.hpp"
+#include "string2map.hpp"
+
+
+namespace siddiqsoft::string2map
+{
+    namespace internal_helpers
+    {
+        /// @brief Random access iterator over an indexable owner (owner[index] yields the element by value).
+        template <typename Owner, typename Value> class indexed_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = Value;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = value_type;
+
+            indexed_iterator() = default;
+
+            indexed_iterator(const Owner* owner, size_t index)
+                : owner_(owner)
+                , index_(index)
+            {
+            }
+
+            value_type operator*() const { return (*owner_)[index_]; }
+            value_type operator[](difference_type n) const { return (*owner_)[index_ + n]; }
+
+            indexed_iterator& operator++()
+            {
+                ++index_;
+                return *this;
+            }
+            indexed_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++index_;
+                return tmp;
+            }
+            indexed_iterator& operator--()
+            {
+                --index_;
+                return *this;
+            }
+            indexed_iterator operator--(int)
+            {
+                auto tmp = *this;
+                --index_;
+                return tmp;
+            }
+            indexed_iterator& operator+=(difference_type n)
+            {
+                index_ += n;
+                return *this;
+            }
+            indexed_iterator& operator-=(difference_type n)
+            {
+                index_ -= n;
+                return *this;
+            }
+            friend indexed_iterator operator+(indexed_iterator it, difference_type n) { return it += n; }
+            friend indexed_iterator operator+(difference_type n, indexed_iterator it) { return it += n; }
+            friend indexed_iterator operator-(indexed_iterator it, difference_type n) { return it -= n; }
+            friend difference_type  operator-(const indexed_iterator& a, const indexed_iterator& b)
+            {
+                return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+            }
+            friend bool operator==(const indexed_iterator& a, const indexed_iterator& b) { return a.index_ == b.index_; }
+            friend auto operator<=>(const indexed_iterator& a, const indexed_iterator& b) { return a.index_ <=> b.index_; }
+
+        private:
+            const Owner* owner_ {nullptr};
+            size_t       index_ {0};
+        };
+    } // namespace internal_helpers
+
+
+    /// @brief The key-value pairs of a batch of independent records stored in one arena: every key and value is
+    ///        appended to a single shared string and each pair is an offset and two lengths into it. The pairs of all
+    ///        the records are stored back-to-back in record order; each record is the range of pairs it produced and
+    ///        the number of elements of its source consumed. Building the result of N records therefore costs a
+    ///        handful of allocations rather than N containers with a node (or two strings) per pair.
+    ///        Duplicate keys are preserved in source order (find returns the first). The views returned remain valid
+    ///        until the next modification.
+    /// @tparam C Character type (char or wchar_t)
+    template <typename C = char> class batch_result
+    {
+    public:
+        using char_type   = C;
+        using string_type = std::basic_string<C>;
+        using view_type   = std::basic_string_view<C>;
+        using value_type  = std::pair<view_type, view_type>;
+        using size_type   = size_t;
+
+        /// @brief The key-value pairs parsed from one record.
+        class record
+        {
+        public:
+            using value_type = batch_result::value_type;
+            using iterator   = internal_helpers::indexed_iterator<record, value_type>;
+
+            record() = default;
+
+            value_type operator[](size_type i) const noexcept { return owner_->element(first_ + i); }
+
+            /// @return Iterator to the first pair with the given key or end()
+            iterator find(view_type key) const noexcept
+            {
+                for (size_type i = 0; i < size(); ++i)
+                {
+                    if ((*this)[i].first == key) return {this, i};
+                }
+                return end();
+            }
+
+            bool contains(view_type key) const noexcept { return find(key) != end(); }
+
+            /// @return The value of the first pair with the given key
+            /// @throws std::out_of_range if the key is not present
+            view_type at(view_type key) const
+            {
+                if (auto it = find(key); it != end()) return (*it).second;
+                throw std::out_of_range("batch_result::record::at key not found");
+            }
+
+            iterator  begin() const noexcept { return {this, 0}; }
+            iterator  end() const noexcept { return {this, size()}; }
+            size_type size() const noexcept { return last_ - first_; }
+            bool      empty() const noexcept { return first_ == last_; }
+
+            /// @brief Number of elements of the source record consumed (as reported by parse).
+            size_type consumed() const noexcept { return consumed_; }
+
+        private:
+            friend class batch_result;
+
+            record(const batch_result* owner, size_type first, size_type last, size_type consumed)
+                : owner_(owner)
+                , first_(first)
+                , last_(last)
+                , consumed_(consumed)
+            {
+            }
+
+            const batch_result* owner_ {nullptr};
+            size_type           first_ {0};
+            size_type           last_ {0};
+            size_type           consumed_ {0};
+        };
+
+        using iterator       = internal_helpers::indexed_iterator<batch_result, record>;
+        using const_iterator = iterator;
+
+        batch_result() = default;
+
+        /// @brief Reserve room for the given number of records, pairs and elements of key and value text.
+        void reserve(size_type records, size_type pairs, size_type elements)
+        {
+            records_.reserve(records);
+            entries_.reserve(pairs);
+            arena_.reserve(elements);
+        }
+
+        /// @brief Remove all records keeping the capacity for reuse.
+        void clear() noexcept
+        {
+            records_.clear();
+            entries_.clear();
+            arena_.clear();
+        }
+
+        /// @brief Append a key-value pair to the record under construction (the one completed by the next end_record).
+        void emplace(view_type key, view_type value)
+        {
+            if (key.size() > UINT32_MAX || value.size() > UINT32_MAX) throw std::length_error("batch_result element exceeds 4GB");
+
+            entries_.push_back({arena_.size(), static_cast<std::uint32_t>(key.size()), static_cast<std::uint32_t>(value.size())});
+            arena_.append(key).append(value);
+        }
+
+        /// @brief Complete the record under construction: it holds every pair emplaced since the previous record.
+        void end_record(size_type consumed) { records_.push_back({entries_.size(), consumed}); }
+
+        /// @brief Append the records of other after those of this result.
+        void append(const batch_result& other)
+        {
+            const auto pairBase  = entries_.size();
+            const auto arenaBase = arena_.size();
+
+            arena_.append(other.arena_);
+            entries_.reserve(pairBase + other.entries_.size());
+            for (auto e : other.entries_)
+            {
+                e.offset += arenaBase;
+                entries_.push_back(e);
+            }
+            records_.reserve(records_.size() + other.records_.size());
+            for (auto r : other.records_)
+            {
+                r.last += pairBase;
+                records_.push_back(r);
+            }
+        }
+
+        record operator[](size_type i) const noexcept
+        {
+            return {this, (i == 0) ? 0 : records_[i - 1].last, records_[i].last, records_[i].consumed};
+        }
+
+        /// @throws std::out_of_range if i is not a valid record index
+        record at(size_type i) const
+        {
+            if (i >= records_.size()) throw std::out_of_range("batch_result::at record index out of range");
+            return (*this)[i];
+        }
+
+        iterator  begin() const noexcept { return {this, 0}; }
+        iterator  end() const noexcept { return {this, records_.size()}; }
+        size_type size() const noexcept { return records_.size(); }
+        bool      empty() const noexcept { return records_.empty(); }
+
+        /// @brief Total number of pairs across all records.
+        size_type pairs() const noexcept { return entries_.size(); }
+
+        /// @brief The backing string holding every key and value back-to-back.
+        const string_type& arena() const noexcept { return arena_; }
+
+    private:
+        struct entry
+        {
+            size_t        offset;
+            std::uint32_t keyLength;
+            std::uint32_t valueLength;
+        };
+
+        struct record_end
+        {
+            /// @brief One past the index of the record's last pair
+            size_t last;
+            size_t consumed;
+        };
+
+        value_type element(size_type i) const noexcept
+        {
+            const auto& e = entries_[i];
+            view_type   a {arena_};
+            return {a.substr(e.offset, e.keyLength), a.substr(e.offset + e.keyLength, e.valueLength)};
+        }
+
+        std::vector<record_end> records_ {};
+        std::vector<entry>      entries_ {};
+        string_type             arena_ {};
+    };
+
+
+    namespace internal_helpers
+    {
+        /// @brief Parse each of the records into the result; the scanner is prepared once for the whole span.
+        template <typename C>
+        static void parse_records(batch_result<C>&                           result,
+                                  std::span<const std::basic_string_view<C>> records,
+                                  const runtime_delimiters<C>&               delimiters)
+        {
+            size_t elements = 0;
+            for (const auto& src : records)
+                elements += src.size();
+            // The key and value text of a record never exceeds the record.
+            result.reserve(result.size() + records.size(), result.pairs() + records.size(), result.arena().size() + elements);
+
+            const pair_scanner<C> initial {delimiters};
+            for (const auto& src : records)
+            {
+                auto scanner = initial;
+                scanner.scan(src, true, [&](std::basic_string_view<C> key, std::basic_string_view<C> value) { result.emplace(key, value); });
+                result.end_record(scanner.consumed());
+            }
+        }
+
+        /// @brief View each record as std::basic_string_view (a no-op for views).
+        template <typename T> static auto record_views(std::span<const T> records)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            if constexpr (std::is_same_v<T, view_t>)
+                return records;
+            else
+                return std::vector<view_t>(records.begin(), records.end());
+        }
+    } // namespace internal_helpers
+
+
+    /// @brief Parse a batch of independent records (for example the lines of a log) with the same delimiters in one
+    ///        call. Each record is parsed exactly as parse would parse it on its own; the delimiters are checked and
+    ///        the scanner prepared once for the batch and the pairs of every record are stored in a single
+    ///        batch_result arena instead of a container per record.
+    /// @tparam T std::string, std::wstring (any allocator), std::string_view or std::wstring_view
+    /// @param records The records; nothing refers to them once the call returns
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which ends each record. Stop processing if we encounter this value.
+    /// @return One record of the result per input record, in the same order
+    template <typename T>
+    static auto parse_batch(std::type_identity_t<std::span<const T>> records,
+                            const T&                                 keyDelimiter,
+                            const T&                                 valueDelimiter,
+                            const T&                                 terminalDelimiter = T {}) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_scannable_v<T>)
+        {
+            using char_t = typename T::value_type;
+            using view_t = std::basic_string_view<char_t>;
+
+            batch_result<char_t> result {};
+            const auto           views = internal_helpers::record_views(records);
+            internal_helpers::parse_records<char_t>(
+                    result, views, internal_helpers::runtime_delimiters<char_t> {view_t {keyDelimiter}, view_t {valueDelimiter}, view_t {terminalDelimiter}});
+            return result;
+        }
+
+        throw std::runtime_error("parse_batch() records must be string, wstring, string_view or wstring_view");
+    }
+
+
+    /// @brief Parse a batch of independent records as parse_batch, dividing the records among multiple threads. The
+    ///        records are split into contiguous runs of roughly equal total size (subject to options.min_chunk
+    ///        elements per run); each thread fills its own batch_result and the runs are concatenated in order so
+    ///        the result is identical to the serial parse_batch.
+    /// @param options Thread count and minimum number of elements of the records per thread
+    /// @return One record of the result per input record, in the same order
+    template <typename T>
+    static auto parse_batch(std::type_identity_t<std::span<const T>> records,
+                            const T&                                 keyDelimiter,
+                            const T&                                 valueDelimiter,
+                            const T&                                 terminalDelimiter,
+                            const parallel_parse::options&           options) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_scannable_v<T>)
+        {
+            using char_t = typename T::value_type;
+            using view_t = std::basic_string_view<char_t>;
+
+            const auto views = internal_helpers::record_views(records);
+            const internal_helpers::runtime_delimiters<char_t> delimiters {view_t {keyDelimiter}, view_t {valueDelimiter}, view_t {terminalDelimiter}};
+
+            size_t total = 0;
+            for (const auto& src : views)
+                total += src.size();
+
+            // Map the nominal (element) boundaries onto the first record starting at or beyond each of them.
+            const auto          nominal = parallel_parse::internal_helpers::nominal_boundaries(total, options);
+            std::vector<size_t> starts {0};
+            size_t              offset = 0;
+            for (size_t i = 0, b = 1; i < views.size() && b < nominal.size(); offset += views[i++].size())
+            {
+                if (offset < nominal[b]) continue;
+                // offset > 0 here (every nominal boundary after the first is at least min_chunk) so i > starts.back()
+                starts.push_back(i);
+                while (b < nominal.size() && nominal[b] <= offset)
+                    ++b;
+            }
+            starts.push_back(views.size());
+
+            batch_result<char_t> result {};
+            if (starts.size() < 3)
+            {
+                internal_helpers::parse_records<char_t>(result, views, delimiters);
+                return result;
+            }
+
+            const std::span<const view_t>     all {views};
+            std::vector<batch_result<char_t>> parts(starts.size() - 1);
+            parallel_parse::internal_helpers::run_chunks(parts.size(), [&](size_t i) {
+                internal_helpers::parse_records<char_t>(parts[i], all.subspan(starts[i], starts[i + 1] - starts[i]), delimiters);
+            });
+
+            size_t pairs = 0, elements = 0;
+            for (const auto& part : parts)
+            {
+                pairs += part.pairs();
+                elements += part.arena().size();
+            }
+            result.reserve(views.size(), pairs, elements);
+            for (const auto& part : parts)
+                result.append(part);
+            return result;
+        }
+
+        throw std::runtime_error("parse_batch() records must be string, wstring, string_view or wstring_view");
+    }
+
+
+    /// @brief Records parsed into columns (struct-of-arrays): each distinct key is interned once in a dictionary (ids
+    ///        in order of first appearance) and every key has a column holding, for each row (record), the offset and
+    ///        length of its value in the source buffer or a null marker when the record lacks the key. A cell is 8 bytes
+    ///        (the offset is relative to the start of the row's record) so a scan of one column touches only that
+    ///        column's contiguous cells and allocates nothing.
+    ///        When a key repeats within a record the first value is kept (as with parse into std::map).
+    ///        The table refers to the source buffer: it must outlive the table.
+    /// @tparam C Character type (char or wchar_t)
+    template <typename C = char> class column_table
+    {
+    public:
+        using char_type = C;
+        using view_type = std::basic_string_view<C>;
+        using size_type = size_t;
+
+        /// @brief Length stored in the cells of rows which lack the key.
+        static constexpr std::uint32_t null_length = UINT32_MAX;
+
+        /// @brief The position of one value in its record.
+        struct cell
+        {
+            std::uint32_t offset {0};
+            std::uint32_t length {null_length};
+
+            constexpr bool is_null() const noexcept { return length == null_length; }
+        };
+
+        /// @brief The values of one key for every row.
+        class column
+        {
+        public:
+            using value_type = std::optional<view_type>;
+            using iterator   = internal_helpers::indexed_iterator<column, value_type>;
+
+            column() = default;
+
+            /// @return The value of the key in the given row or std::nullopt when the row lacks the key
+            value_type operator[](size_type row) const noexcept
+            {
+                const auto& c = cells_[row];
+                return c.is_null() ? value_type {} : value_type {source_.substr(rows_[row] + c.offset, c.length)};
+            }
+
+            bool is_null(size_type row) const noexcept { return cells_[row].is_null(); }
+
+            /// @brief Position of the row's value in the source buffer (meaningless for a null).
+            size_type offset(size_type row) const noexcept { return rows_[row] + cells_[row].offset; }
+
+            /// @brief The raw cells (offsets relative to each row's record) for scans which avoid materializing views.
+            std::span<const cell> cells() const noexcept { return cells_; }
+
+            iterator  begin() const noexcept { return {this, 0}; }
+            iterator  end() const noexcept { return {this, cells_.size()}; }
+            size_type size() const noexcept { return cells_.size(); }
+
+        private:
+            friend class column_table;
+
+            column(view_type source, std::span<const size_type> rows, std::span<const cell> cells)
+                : source_(source)
+                , rows_(rows)
+                , cells_(cells)
+            {
+            }
+
+            view_type                  source_ {};
+            std::span<const size_type> rows_ {};
+            std::span<const cell>      cells_ {};
+        };
+
+        column_table() = default;
+
+        explicit column_table(view_type source)
+            : source_(source)
+        {
+        }
+
+        /// @brief Capacity reserved by each column when its key first appears (the expected number of rows).
+        void reserve(size_type rows)
+        {
+            expectedRows_ = rows;
+            rowOffsets_.reserve(rows);
+        }
+
+        /// @brief Begin a new row for the given record (a view of the source buffer); every column is null in it until set.
+        void add_row(view_type record)
+        {
+            if (record.size() >= null_length) throw std::length_error("column_table record exceeds 4GB");
+
+            rowOffsets_.push_back(static_cast<size_type>(record.data() - source_.data()));
+            ++rows_;
+            hint_     = rowFirst_;
+            rowStart_ = true;
+        }
+
+        /// @brief Pad every column with nulls up to the last row. The columns are only extended when a value is set
+        ///        (so a row costs nothing in the columns it lacks) and must be completed before they are read.
+        void complete()
+        {
+            for (auto& cells : columns_)
+                cells.resize(rows_);
+        }
+
+        /// @brief Set the key's value in the last row (the key is interned on first use). A key already set in the row
+        ///        keeps its value. Both views must refer to the row's record.
+        /// @return The id of the key
+        size_type set(view_type key, view_type value)
+        {
+            if (rows_ == 0) throw std::logic_error("column_table::set before add_row");
+
+            const auto id    = intern(key);
+            auto&      cells = columns_[id];
+            if (cells.size() < rows_) cells.resize(rows_);
+            auto& cell = cells.back();
+            if (cell.is_null())
+                cell = {static_cast<std::uint32_t>(value.data() - source_.data() - rowOffsets_.back()), static_cast<std::uint32_t>(value.size())};
+            return id;
+        }
+
+        /// @return The id of the key or std::nullopt if no row has it
+        std::optional<size_type> key_id(view_type key) const
+        {
+            if (const auto slot = probe(key, key_hash<case_sensitive>(key)); !slots_.empty() && slots_[slot] != 0) return slots_[slot] - 1;
+            return std::nullopt;
+        }
+
+        /// @brief The interned keys; the index is the key id.
+        std::span<const view_type> keys() const noexcept { return keys_; }
+
+        /// @brief The column of the key with the given id.
+        column operator[](size_type id) const noexcept { return {source_, rowOffsets_, columns_[id]}; }
+
+        /// @return The column of the given key
+        /// @throws std::out_of_range if no row has the key
+        column at(view_type key) const
+        {
+            if (auto id = key_id(key)) return (*this)[*id];
+            throw std::out_of_range("column_table::at key not found");
+        }
+
+        bool contains(view_type key) const { return key_id(key).has_value(); }
+
+        /// @brief Number of rows (records).
+        size_type rows() const noexcept { return rows_; }
+
+        /// @brief Number of columns (distinct keys).
+        size_type columns() const noexcept { return keys_.size(); }
+
+        view_type source() const noexcept { return source_; }
+
+    private:
+        /// @brief Key id. The key which followed the previous key in the previous record is checked before the
+        ///        dictionary since the records of a log typically list the same keys in the same order.
+        size_type intern(view_type key)
+        {
+            size_type id = hint_;
+            if (hint_ >= keys_.size() || keys_[hint_] != key)
+            {
+                const auto h    = key_hash<case_sensitive>(key);
+                auto       slot = probe(key, h);
+                if (slots_.empty() || slots_[slot] == 0)
+                {
+                    id = keys_.size();
+                    keys_.push_back(key);
+                    hashes_.push_back(h);
+                    columns_.emplace_back().reserve(expectedRows_);
+                    if (keys_.size() * 2 > slots_.size())
+                        rehash();
+                    else
+                        slots_[slot] = static_cast<std::uint32_t>(id + 1);
+                }
+                else
+                {
+                    id = slots_[slot] - 1;
+                }
+            }
+
+            if (rowStart_) rowFirst_ = id;
+            rowStart_ = false;
+            hint_     = id + 1;
+            return id;
+        }
+
+        /// @brief Slot holding the key or the empty slot where it belongs (linear probing).
+        size_type probe(view_type key, std::uint32_t h) const noexcept
+        {
+            if (slots_.empty()) return 0;
+
+            const size_type mask = slots_.size() - 1;
+            for (size_type slot = h & mask;; slot = (slot + 1) & mask)
+            {
+                const auto id = slots_[slot];
+                if (id == 0 || (hashes_[id - 1] == h && keys_[id - 1] == key)) return slot;
+            }
+        }
+
+        /// @brief Double the dictionary (at most half full) and reinsert every key.
+        void rehash()
+        {
+            slots_.assign((slots_.size() != 0) ? slots_.size() * 2 : 64, 0);
+            for (size_type id = 0; id < keys_.size(); ++id)
+                slots_[probe(keys_[id], hashes_[id])] = static_cast<std::uint32_t>(id + 1);
+        }
+
+        view_type                                source_ {};
+        std::vector<view_type>                   keys_ {};
+        std::vector<std::uint32_t>               hashes_ {};
+        /// @brief Open addressed dictionary of key id + 1 (0 is empty)
+        std::vector<std::uint32_t>               slots_ {};
+        std::vector<std::vector<cell>>           columns_ {};
+        /// @brief Start of each row's record in the source
+        std::vector<size_type>                   rowOffsets_ {};
+        size_type                                rows_ {0};
+        size_type                                expectedRows_ {0};
+        size_type                                hint_ {0};
+        size_type                                rowFirst_ {0};
+        bool                                     rowStart_ {false};
+    };
+
+
+    /// @brief Parse the records of a buffer (for example the lines of a log file) straight into columns: each non-empty
+    ///        record separated by recordDelimiter becomes a row and its key-value pairs are parsed as parse would
+    ///        parse the record on its own. The cells refer to src (which must outlive the result).
+    /// @tparam T std::string_view or std::wstring_view
+    /// @param src The source buffer
+    /// @param recordDelimiter Separates the records. Example: "\n"; empty treats src as a single record
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter Separates the pairs of a record. Example: "&" or "\t".
+    /// @param terminalDelimiter The "end of frame" delimiter which ends the pairs of each record (the rest of that record is ignored).
+    /// @return The column table with a row for each non-empty record
+    template <typename T>
+    static auto parse_columns(T src, T recordDelimiter, T keyDelimiter, T valueDelimiter, T terminalDelimiter = T {}) noexcept(false)
+    {
+        if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::wstring_view>)
+        {
+            using char_t = typename T::value_type;
+
+            column_table<char_t>                         table {src};
+            const internal_helpers::pair_scanner<char_t> initial {keyDelimiter, valueDelimiter, terminalDelimiter};
+
+            // Estimate the records from a prefix so each column is usually allocated once without reading src twice;
+            // an underestimate regrows geometrically.
+            table.reserve(recordDelimiter.empty()
+                                  ? 1
+                                  : internal_helpers::estimate_pieces(src.substr(0, internal_helpers::reserve_window), src.size(), recordDelimiter));
+
+            for (size_t start = 0; start < src.size();)
+            {
+                auto end = recordDelimiter.empty() ? T::npos : delimiter_scan::find(src, recordDelimiter, start);
+                if (end == T::npos) end = src.size();
+
+                if (end > start)
+                {
+                    const auto record = src.substr(start, end - start);
+                    table.add_row(record);
+                    auto scanner = initial;
+                    scanner.scan(record, true, [&](T key, T value) { table.set(key, value); });
+                }
+                start = end + recordDelimiter.size();
+            }
+            table.complete();
+            return table;
+        }
+
+        throw std::runtime_error("parse_columns() src must be string_view or wstring_view");
+    }
+} // namespace siddiqsoft::string2map
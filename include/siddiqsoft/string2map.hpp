@@ -42,61 +42,706 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <map>
+#include <optional>
 #include <unordered_map>
+#include <array>
+#include <algorithm>
 #include <exception>
+#include <type_traits>
+#include <version>
+#if defined(__cpp_lib_flat_map)
+#include <flat_map>
+#endif
+
+#include "delimiter_scan.hpp"
+#include "flat_header_map.hpp"
+#include "utf_transcode.hpp"
 
 
 namespace siddiqsoft::string2map
 {
     namespace internal_helpers
     {
-        static auto n2w(const std::string& srcStr) -> std::wstring
+        /// @brief Convert UTF-8 to std::wstring (locale independent; invalid sequences become U+FFFD).
+        inline auto n2w(const std::string& srcStr) -> std::wstring
+        {
+            return utf::to_wide(srcStr);
+        }
+
+        /// @brief Convert std::wstring to UTF-8 (locale independent; unpaired surrogates become U+FFFD).
+        inline auto w2n(const std::wstring& srcStr) -> std::string
         {
-            if (srcStr.empty()) return {};
+            return utf::to_utf8(srcStr);
+        }
+
+        /// @brief Delimiters supplied at runtime; the searches use the runtime dispatched kernels.
+        template <typename C> struct runtime_delimiters
+        {
+            using view_t = std::basic_string_view<C>;
+
+            view_t keyDelimiter {};
+            view_t valueDelimiter {};
+            view_t terminalDelimiter {};
+
+            constexpr view_t key() const noexcept { return keyDelimiter; }
+            constexpr view_t value() const noexcept { return valueDelimiter; }
+            constexpr view_t terminal() const noexcept { return terminalDelimiter; }
+
+            constexpr delimiter_scan::match find_key(view_t buffer, size_t terminalFrom, size_t from) const noexcept
+            {
+                return delimiter_scan::find_either(buffer, terminalDelimiter, terminalFrom, keyDelimiter, from);
+            }
+
+            constexpr delimiter_scan::match find_value(view_t buffer, size_t terminalFrom, size_t from) const noexcept
+            {
+                return delimiter_scan::find_either(buffer, terminalDelimiter, terminalFrom, valueDelimiter, from);
+            }
+        };
+
+        /// @brief Delimiters known at compile time; the searches use kernels specialized for each delimiter.
+        template <typename C, delimiter_scan::fixed_string K, delimiter_scan::fixed_string V, delimiter_scan::fixed_string T>
+        struct static_delimiters
+        {
+            using view_t = std::basic_string_view<C>;
+
+            static constexpr view_t key() noexcept { return delimiter_scan::fixed_view<C, K>(); }
+            static constexpr view_t value() noexcept { return delimiter_scan::fixed_view<C, V>(); }
+            static constexpr view_t terminal() noexcept { return delimiter_scan::fixed_view<C, T>(); }
+
+            static constexpr delimiter_scan::match find_key(view_t buffer, size_t terminalFrom, size_t from) noexcept
+            {
+                return delimiter_scan::find_either_fixed<T, K>(buffer, terminalFrom, from);
+            }
+
+            static constexpr delimiter_scan::match find_value(view_t buffer, size_t terminalFrom, size_t from) noexcept
+            {
+                return delimiter_scan::find_either_fixed<T, V>(buffer, terminalFrom, from);
+            }
+        };
+
+        /// @brief Resumable core scanning loop shared by parse, parse_view and stream_parser.
+        /// Walks the buffer once, front to back, and invokes onPair(key, value) with views into the buffer for every
+        /// key-value pair located. The terminal delimiter is detected as part of the same forward scan as the key and
+        /// value delimiters so nothing beyond the terminal delimiter is examined.
+        /// When the buffer is not the last piece of the input the scanner remembers how far each delimiter has been
+        /// checked (allowing for a delimiter split across the end of the buffer) and resumes from there once more data
+        /// has been appended so no element is examined twice.
+        /// @tparam C Character type (char or wchar_t)
+        /// @tparam Delimiters runtime_delimiters or static_delimiters
+        template <typename C, typename Delimiters = runtime_delimiters<C>> class pair_scanner
+        {
+        public:
+            using view_t = std::basic_string_view<C>;
+
+            enum class status
+            {
+                /// @brief More input is required to complete the current element
+                need_more,
+                /// @brief The terminal delimiter has been reached
+                terminated,
+                /// @brief The input has been exhausted (last buffer)
+                finished,
+                /// @brief Malformed input (empty key) or empty delimiters; nothing further is parsed
+                stopped,
+                /// @brief The callback returned false; consumed() is the end of the last element delivered
+                cancelled
+            };
+
+            /// @param unfold Treat a value delimiter followed by a space or tab as an obsolete line fold: the value
+            ///               continues on the next line (the fold is left in the value)
+            constexpr pair_scanner(view_t keyDelimiter, view_t valueDelimiter, view_t terminalDelimiter, bool unfold = false) noexcept
+                : pair_scanner(Delimiters {keyDelimiter, valueDelimiter, terminalDelimiter}, unfold)
+            {
+            }
+
+            constexpr explicit pair_scanner(Delimiters delimiters, bool unfold = false) noexcept
+                : unfold_(unfold)
+                , delimiters_(delimiters)
+                , keyDelimiter_(delimiters.key())
+                , valueDelimiter_(delimiters.value())
+                , terminalDelimiter_(delimiters.terminal())
+                // Guard: empty delimiters yield no results.
+                , status_((keyDelimiter_.empty() || valueDelimiter_.empty()) ? status::stopped : status::need_more)
+            {
+            }
+
+            /// @brief Scan the buffer from where the previous call left off.
+            /// @param buffer All of the input not yet discarded; positions are relative to its start
+            /// @param last True if no further input will be appended to the buffer
+            /// @param onPair Invoked for each key-value pair in source order
+            /// @return The status; once it is anything other than need_more the scanner is done
+            template <typename F> constexpr status scan(view_t buffer, bool last, F&& onPair)
+            {
+                const size_t n = buffer.size();
+
+                while (status_ == status::need_more)
+                {
+                    if (!inValue_)
+                    {
+                        // Nothing left to parse.
+                        if (keyStart_ >= n) return last ? finish(keyStart_, status::finished) : status_;
+
+                        auto keyEnd = delimiters_.find_key(buffer, terminalFrom_, searchFrom_);
+
+                        // Reached the end of the frame before the next key.
+                        if (keyEnd.needle == 0) return finish(keyEnd.position + terminalDelimiter_.length(), status::terminated);
+                        // No key end was located; break
+                        if (!keyEnd.found()) return last ? finish(keyStart_, status::stopped) : suspend(n, keyDelimiter_.length());
+                        if (!last && terminal_pending(buffer, keyEnd.position)) return suspend_at(n, keyEnd.position);
+
+                        // Found a key; Empty key means we must break out of the loop
+                        if (keyEnd.position == keyStart_) return finish(keyStart_, status::stopped);
+
+                        keyEnd_       = keyEnd.position;
+                        inValue_      = true;
+                        searchFrom_   = keyEnd_ + keyDelimiter_.length();
+                        terminalFrom_ = keyEnd_ + 1;
+                    }
+
+                    // Search for value delimiter, but only up to the terminal delimiter boundary.
+                    const size_t valueStart = keyEnd_ + keyDelimiter_.length();
+                    auto         valueEnd   = delimiters_.find_value(buffer, terminalFrom_, searchFrom_);
+                    const view_t key        = buffer.substr(keyStart_, keyEnd_ - keyStart_);
+
+                    if (valueEnd.needle == 0)
+                    {
+                        // Value is clamped at the terminal delimiter (empty if the key delimiter overlaps the terminal).
+                        onPair(key, buffer.substr(valueStart, valueEnd.position > valueStart ? valueEnd.position - valueStart : 0));
+                        return finish(valueEnd.position + terminalDelimiter_.length(), status::terminated);
+                    }
+
+                    if (!valueEnd.found())
+                    {
+                        if (!last) return suspend(n, valueDelimiter_.length());
+                        // Value extends to end of parseable region
+                        onPair(key, buffer.substr(valueStart));
+                        return finish(n, status::finished);
+                    }
+
+                    if (!last && terminal_pending(buffer, valueEnd.position)) return suspend_at(n, valueEnd.position);
+
+                    if (unfold_)
+                    {
+                        // A continuation line: the value resumes after the fold (the next element decides)
+                        const size_t next = valueEnd.position + valueDelimiter_.length();
+                        if (next >= n && !last) return suspend_at(n, valueEnd.position);
+                        if (next < n && (buffer[next] == C(' ') || buffer[next] == C('\t')))
+                        {
+                            searchFrom_ = next;
+                            folded_     = true;
+                            continue;
+                        }
+                    }
+
+                    const bool proceed = emit(onPair, key, buffer.substr(valueStart, valueEnd.position - valueStart));
+
+                    // Advance to the next potential element.
+                    inValue_      = false;
+                    folded_       = false;
+                    terminalFrom_ = valueEnd.position + 1;
+                    keyStart_     = valueEnd.position + valueDelimiter_.length();
+                    searchFrom_   = keyStart_;
+                    consumed_     = keyStart_;
+                    if (!proceed) return finish(keyStart_, status::cancelled);
+                }
+
+                return status_;
+            }
+
+            /// @brief Number of elements consumed: up to and including the terminal delimiter when it has been found,
+            ///        otherwise up to the end of the last complete element.
+            constexpr size_t consumed() const noexcept { return consumed_; }
+
+            /// @brief Number of leading elements of the buffer which are no longer required by the scanner.
+            constexpr size_t settled() const noexcept { return (!inValue_ && terminalFrom_ < keyStart_) ? terminalFrom_ : keyStart_; }
+
+            /// @brief Rebase the positions after the caller removed count (at most settled()) elements from the front of the buffer.
+            constexpr void discard(size_t count) noexcept
+            {
+                keyStart_ -= count;
+                keyEnd_ -= inValue_ ? count : 0;
+                searchFrom_ -= count;
+                terminalFrom_ -= count;
+                consumed_ -= (consumed_ > count) ? count : consumed_;
+            }
 
-            std::mbstate_t state = std::mbstate_t();
-            const char*    mbstr = srcStr.c_str();
-            std::size_t    len   = std::mbsrtowcs(nullptr, &mbstr, 0, &state);
+            constexpr status state() const noexcept { return status_; }
 
-            // If the length query itself fails, return empty.
-            if (len == static_cast<std::size_t>(-1)) return {};
+            /// @brief True (while onPair runs) if the current value spans a line fold; only set when unfolding.
+            constexpr bool folded() const noexcept { return folded_; }
+
+        private:
+            /// @brief Invoke the callback; one returning bool may return false to stop the scan.
+            template <typename F> static constexpr bool emit(F& onPair, view_t key, view_t value)
+            {
+                if constexpr (std::is_same_v<std::invoke_result_t<F&, view_t, view_t>, bool>)
+                    return onPair(key, value);
+                else
+                {
+                    onPair(key, value);
+                    return true;
+                }
+            }
 
-            std::vector<wchar_t> wstr(len + 1);
+            constexpr status finish(size_t consumed, status final) noexcept
+            {
+                consumed_ = consumed;
+                return status_ = final;
+            }
 
-            if (auto resultLen = std::mbsrtowcs(&wstr[0], &mbstr, wstr.size(), &state);
-                resultLen != static_cast<std::size_t>(-1))
-                return {wstr.data(), resultLen};
-            // Failure
-            return {};
+            /// @brief Nothing found: every position up to the last length-1 elements has been checked.
+            constexpr status suspend(size_t n, size_t length) noexcept
+            {
+                const size_t resumeFrom = (n + 1 > length) ? n + 1 - length : 0;
+                searchFrom_             = (searchFrom_ > resumeFrom) ? searchFrom_ : resumeFrom;
+                const size_t termFrom   = (n + 1 > terminalDelimiter_.length()) ? n + 1 - terminalDelimiter_.length() : 0;
+                terminalFrom_           = (terminalFrom_ > termFrom) ? terminalFrom_ : termFrom;
+                return status_;
+            }
+
+            /// @brief A delimiter was found at pos but the terminal delimiter may still start at or before it.
+            constexpr status suspend_at(size_t n, size_t pos) noexcept
+            {
+                searchFrom_           = pos;
+                const size_t termFrom = (n + 1 > terminalDelimiter_.length()) ? n + 1 - terminalDelimiter_.length() : 0;
+                terminalFrom_         = (terminalFrom_ > termFrom) ? terminalFrom_ : termFrom;
+                return status_;
+            }
+
+            /// @brief True if the tail of the buffer from a position at or before pos is a prefix of the terminal delimiter.
+            constexpr bool terminal_pending(view_t buffer, size_t pos) const noexcept
+            {
+                if (terminalDelimiter_.empty()) return false;
+
+                const size_t n = buffer.size();
+                // Positions up to n - length have been fully checked by find_either.
+                for (size_t p = (n + 1 > terminalDelimiter_.length()) ? n + 1 - terminalDelimiter_.length() : 0; p <= pos && p < n; ++p)
+                {
+                    if (p >= terminalFrom_ && terminalDelimiter_.starts_with(buffer.substr(p))) return true;
+                }
+                return false;
+            }
+
+            bool       unfold_ {false};
+            bool       folded_ {false};
+            Delimiters delimiters_ {};
+            view_t     keyDelimiter_ {};
+            view_t     valueDelimiter_ {};
+            view_t     terminalDelimiter_ {};
+            status     status_ {status::need_more};
+            bool       inValue_ {false};
+            size_t     keyStart_ {0};
+            size_t     keyEnd_ {0};
+            size_t     searchFrom_ {0};
+            size_t     terminalFrom_ {0};
+            size_t     consumed_ {0};
+        };
+
+        /// @brief Core scanning loop behind for_each_pair (and so parse, parse_view and find_value) over a complete buffer.
+        /// @tparam C Character type (char or wchar_t)
+        /// @tparam F Callable with signature void(std::basic_string_view<C>, std::basic_string_view<C>); it may instead
+        ///           return bool where false stops the scan after that pair
+        /// @param src The source buffer
+        /// @param keyDelimiter Delimiter for the key portion
+        /// @param valueDelimiter The "line terminator" delimiter which defines the value
+        /// @param terminalDelimiter The "end of frame" delimiter; may be empty
+        /// @param onPair Invoked for each key-value pair in source order
+        /// @return Number of elements of src consumed: up to and including the terminal delimiter when it is found, otherwise
+        ///         up to the end of the last element parsed.
+        template <typename C, typename F>
+        static size_t scan_pairs(std::basic_string_view<C> src,
+                                 std::basic_string_view<C> keyDelimiter,
+                                 std::basic_string_view<C> valueDelimiter,
+                                 std::basic_string_view<C> terminalDelimiter,
+                                 F&&                       onPair)
+        {
+            pair_scanner<C> scanner {keyDelimiter, valueDelimiter, terminalDelimiter};
+            scanner.scan(src, true, std::forward<F>(onPair));
+            return scanner.consumed();
         }
 
-        static auto w2n(const std::wstring& srcStr) -> std::string
+        /// @brief True for std::basic_string of char or wchar_t with any allocator (for example std::pmr::string).
+        template <typename S> struct is_string : std::false_type
+        {
+        };
+        template <typename C, typename A>
+        struct is_string<std::basic_string<C, std::char_traits<C>, A>>
+            : std::bool_constant<std::is_same_v<C, char> || std::is_same_v<C, wchar_t>>
+        {
+        };
+
+        /// @brief True for std::map, std::multimap and std::unordered_map of <K, K> with any comparator, hash or allocator.
+        template <typename R, typename K> struct is_map_of : std::false_type
         {
-            if (srcStr.empty()) return {};
+        };
+        template <typename K, typename Cmp, typename A> struct is_map_of<std::map<K, K, Cmp, A>, K> : std::true_type
+        {
+        };
+        template <typename K, typename Cmp, typename A> struct is_map_of<std::multimap<K, K, Cmp, A>, K> : std::true_type
+        {
+        };
+        template <typename K, typename H, typename E, typename A> struct is_map_of<std::unordered_map<K, K, H, E, A>, K> : std::true_type
+        {
+        };
+
+#if defined(__cpp_lib_flat_map)
+        template <typename K, typename Cmp, typename KC, typename MC>
+        struct is_map_of<std::flat_map<K, K, Cmp, KC, MC>, K> : std::true_type
+        {
+        };
+        template <typename K, typename Cmp, typename KC, typename MC>
+        struct is_map_of<std::flat_multimap<K, K, Cmp, KC, MC>, K> : std::true_type
+        {
+        };
+#endif
+
+        /// @brief True for flat_header_map of the destination's character type.
+        template <typename R, typename D> struct is_flat_header_map_of : std::false_type
+        {
+        };
+        template <typename C, size_t N, typename P, typename K, typename A>
+        struct is_flat_header_map_of<flat_header_map<C, N, P, K>, std::basic_string<C, std::char_traits<C>, A>> : std::true_type
+        {
+        };
+
+        /// @brief True for std::vector<std::pair<K, K>> with any allocator.
+        template <typename R, typename K> struct is_vector_of : std::false_type
+        {
+        };
+        template <typename K, typename A> struct is_vector_of<std::vector<std::pair<K, K>, A>, K> : std::true_type
+        {
+        };
 
-            std::mbstate_t state = std::mbstate_t();
-            const wchar_t* wstr = srcStr.c_str();
-            std::size_t    len  = std::wcsrtombs(nullptr, &wstr, 0, &state);
+        /// @brief The destination string type of the container: its key_type or, for flat_header_map, its string_type.
+        template <typename R> struct destination_of
+        {
+            using type = typename R::key_type;
+        };
+        template <typename C, size_t N, typename P, typename K> struct destination_of<flat_header_map<C, N, P, K>>
+        {
+            using type = typename flat_header_map<C, N, P, K>::string_type;
+        };
 
-            // If the length query itself fails, return empty.
-            if (len == static_cast<std::size_t>(-1)) return {};
+        /// @brief True for the source, destination and container combinations supported by parse.
+        template <typename T, typename D, typename R>
+        inline constexpr bool is_supported_v =
+                is_string<T>::value && is_string<D>::value && (is_map_of<R, D>::value || is_flat_header_map_of<R, D>::value);
 
-            std::vector<char> mbstr(len + 1);
+        /// @brief The container's allocator type or std::allocator<void> for containers without one (flat_header_map, std::flat_map).
+        template <typename R> struct allocator_of
+        {
+            using type = std::allocator<void>;
+        };
+        template <typename R>
+            requires requires { typename R::allocator_type; }
+        struct allocator_of<R>
+        {
+            using type = typename R::allocator_type;
+        };
 
-            if (auto resultLen = std::wcsrtombs(&mbstr[0], &wstr, mbstr.size(), &state);
-                resultLen != static_cast<std::size_t>(-1))
-                return {mbstr.data(), resultLen};
-            // Failure
-            return {};
+        /// @brief Construct the container with the allocator when it accepts one.
+        template <typename R> static R make_container(const typename allocator_of<R>::type& allocator)
+        {
+            if constexpr (std::is_constructible_v<R, const typename allocator_of<R>::type&>)
+                return R(allocator);
+            else
+                return R {};
+        }
+
+        /// @brief The allocator for the strings stored in the container: rebound from the container's allocator so that
+        ///        keys and values come from the same source (for example a std::pmr::monotonic_buffer_resource).
+        template <typename D, typename R> static typename D::allocator_type string_allocator(const R& resultMap)
+        {
+            if constexpr (std::is_constructible_v<typename D::allocator_type, typename allocator_of<R>::type> &&
+                          requires { resultMap.get_allocator(); })
+                return typename D::allocator_type(resultMap.get_allocator());
+            else
+                return typename D::allocator_type {};
         }
+
+        /// @brief Assign the source view to the destination string converting between string and wstring as required.
+        template <typename D, typename C> static void assign_to(D& dst, std::basic_string_view<C> src)
+        {
+            if constexpr (std::is_same_v<typename D::value_type, C>)
+            {
+                // Transformation not needed
+                dst.assign(src.data(), src.size());
+            }
+            else if constexpr (std::is_same_v<C, char>)
+            {
+                // From UTF-8 string to wstring; written directly into the destination
+                utf::utf8_to_wide(src, dst);
+            }
+            else
+            {
+                // From wstring to UTF-8 string; written directly into the destination
+                utf::wide_to_utf8(src, dst);
+            }
+        }
+
+        /// @brief Converts (if required) the key-value views into D, using the container's allocator, and adds them to the container.
+        template <typename D, typename R, typename C>
+        static void insert_pair(R& resultMap, std::basic_string_view<C> key, std::basic_string_view<C> value)
+        {
+            if constexpr (is_flat_header_map_of<R, D>::value && std::is_same_v<typename D::value_type, C>)
+            {
+                // The arena holds the text; no intermediate strings
+                resultMap.emplace(key, value);
+            }
+            else
+            {
+                const auto alloc = string_allocator<D>(resultMap);
+
+                D k(alloc);
+                assign_to(k, key);
+                D v(alloc);
+                assign_to(v, value);
+                // The strings share the container's allocator so they are moved (not copied) into the element.
+                resultMap.emplace(std::move(k), std::move(v));
+            }
+        }
+
+        /// @brief The number of elements of the source counted ahead of a scan to size its containers.
+        inline constexpr size_t reserve_window = 4096;
+
+        /// @brief Estimate the pieces a text of the given length splits into at the delimiter from a vectorized count
+        ///        over its prefix (at most reserve_window elements), scaled to the length and rounded up.
+        template <typename C>
+        static size_t estimate_pieces(std::basic_string_view<C> prefix, size_t length, std::basic_string_view<C> delimiter)
+        {
+            const size_t pieces = delimiter_scan::count(prefix, delimiter) + 1;
+            return (length > prefix.size() && !prefix.empty()) ? (pieces * length + prefix.size() - 1) / prefix.size() : pieces;
+        }
+
+        /// @brief Reserve the container for the pairs of src ahead of the scan so that a std::vector does not reallocate
+        ///        as it grows. The pairs are estimated from the value delimiters in a bounded prefix of src (plus one for a
+        ///        final pair without a value delimiter); the prefix is read again by the scan while it is still in cache.
+        ///        The count stops at a terminal delimiter within the prefix so a body is not counted. Without one, all of
+        ///        the prefix is pairs and a longer src is estimated from its density. A flat_header_map also reserves its
+        ///        arena. Node based containers gain nothing from it (an up-front bucket array was measured slower than
+        ///        rehashing as the nodes are allocated anyway) and neither they nor std::map are counted.
+        template <typename R, typename C>
+        static void reserve_pairs(R&                        resultMap,
+                                  std::basic_string_view<C> src,
+                                  std::basic_string_view<C> valueDelimiter,
+                                  std::basic_string_view<C> terminalDelimiter)
+        {
+            constexpr bool sized = requires { resultMap.reserve(size_t {}, size_t {}); };
+
+            if constexpr (sized || is_vector_of<R, std::basic_string_view<C>>::value)
+            {
+                if (valueDelimiter.empty() || src.empty()) return;
+
+                auto   prefix = src.substr(0, reserve_window);
+                size_t text   = src.size();
+                if (!terminalDelimiter.empty())
+                {
+                    if (const auto at = delimiter_scan::find(prefix, terminalDelimiter); at != prefix.npos)
+                    {
+                        prefix = prefix.substr(0, at);
+                        text   = at;
+                    }
+                }
+                const size_t pairs = estimate_pieces(prefix, text, valueDelimiter);
+
+                if constexpr (sized)
+                    resultMap.reserve(pairs, text);
+                else
+                    resultMap.reserve(pairs);
+            }
+        }
+
+        /// @brief Parse the src into the given container.
+        /// @return Number of elements of src consumed
+        template <typename T, typename D, typename R>
+        static size_t parse_to(R& resultMap, const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            reserve_pairs(resultMap, view_t {src}, view_t {valueDelimiter}, view_t {terminalDelimiter});
+            return scan_pairs<typename T::value_type>(
+                    view_t {src}, view_t {keyDelimiter}, view_t {valueDelimiter}, view_t {terminalDelimiter}, [&](view_t key, view_t value) {
+                        insert_pair<D>(resultMap, key, value);
+                    });
+        }
+
+        /// @brief Clear the container and parse the src into it, recycling the existing nodes: each node is extracted and
+        ///        its key and value are reassigned in place (keeping their capacity) before it is re-inserted. Nodes which
+        ///        are not needed (or rejected as duplicate keys) are released at the end. Clearing an unordered_map does
+        ///        not shrink its bucket array so that is also kept.
+        /// @return Number of elements of src consumed
+        template <typename T, typename D, typename R>
+        static size_t refill(R& resultMap, const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            if constexpr (!requires { typename R::node_type; })
+            {
+                // Containers without nodes (flat_header_map, std::flat_map) keep their storage across clear()
+                resultMap.clear();
+                return parse_to<T, D>(resultMap, src, keyDelimiter, valueDelimiter, terminalDelimiter);
+            }
+            else
+            {
+                std::vector<typename R::node_type> pool {};
+                pool.reserve(resultMap.size());
+                while (!resultMap.empty())
+                    pool.push_back(resultMap.extract(resultMap.begin()));
+
+                return scan_pairs<typename T::value_type>(
+                        view_t {src}, view_t {keyDelimiter}, view_t {valueDelimiter}, view_t {terminalDelimiter}, [&](view_t key, view_t value) {
+                            if (pool.empty())
+                            {
+                                insert_pair<D>(resultMap, key, value);
+                                return;
+                            }
+
+                            auto node = std::move(pool.back());
+                            pool.pop_back();
+                            assign_to(node.key(), key);
+                            assign_to(node.mapped(), value);
+                            if constexpr (requires { resultMap.insert(std::move(node)).inserted; })
+                            {
+                                // Unique keys: a rejected node is returned to the pool for the next pair.
+                                auto result = resultMap.insert(std::move(node));
+                                if (!result.inserted) pool.push_back(std::move(result.node));
+                            }
+                            else
+                            {
+                                resultMap.insert(std::move(node));
+                            }
+                        });
+            }
+        }
+
+        /// @brief Adds the key-value pair to the given container using emplace_back for sequence containers
+        ///        and emplace for the associative containers.
+        template <typename R, typename K, typename V>
+        static void emplace_pair(R& resultMap, K&& key, V&& value)
+        {
+            if constexpr (requires { resultMap.emplace_back(std::forward<K>(key), std::forward<V>(value)); })
+                resultMap.emplace_back(std::forward<K>(key), std::forward<V>(value));
+            else
+                resultMap.emplace(std::forward<K>(key), std::forward<V>(value));
+        }
+
+        /// @brief True for the source types accepted by for_each_pair: std::basic_string (any allocator) or
+        ///        std::basic_string_view of char or wchar_t.
+        template <typename T>
+        inline constexpr bool is_scannable_v = is_string<T>::value || std::is_same_v<T, std::string_view> ||
+                                               std::is_same_v<T, std::wstring_view>;
     } // namespace internal_helpers
 
+
+    /// @brief Visit each key-value pair of the src in source order without building a container. This is the core
+    ///        scanning loop underneath parse, parse_view and find_value; the delimiter and terminal semantics are the
+    ///        same as parse. Nothing is allocated.
+    /// @tparam T std::string, std::wstring (any allocator), std::string_view or std::wstring_view
+    /// @tparam F Callable with signature void(view, view) or bool(view, view) where view is the std::basic_string_view
+    ///           of the source's character type. Returning false stops the scan after that pair.
+    /// @param src The source buffer; the views passed to the visitor refer to its storage
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param visitor Invoked for each key-value pair
+    /// @return Number of elements of src consumed: up to and including the terminal delimiter when it is found, up to
+    ///         the end of the pair for which the visitor returned false, otherwise up to the end of the last pair.
+    template <typename T, typename F>
+    static size_t for_each_pair(const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter, F&& visitor) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_scannable_v<T>)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            return internal_helpers::scan_pairs<typename T::value_type>(
+                    view_t {src}, view_t {keyDelimiter}, view_t {valueDelimiter}, view_t {terminalDelimiter}, std::forward<F>(visitor));
+        }
+
+        throw std::runtime_error("for_each_pair() src must be string, wstring, string_view or wstring_view");
+    }
+
+
+    /// @brief Visit each key-value pair of the src in source order without a terminal delimiter; see for_each_pair.
+    /// @return Number of elements of src consumed
+    template <typename T, typename F>
+    static size_t for_each_pair(const T& src, const T& keyDelimiter, const T& valueDelimiter, F&& visitor) noexcept(false)
+    {
+        return for_each_pair(src, keyDelimiter, valueDelimiter, T {}, std::forward<F>(visitor));
+    }
+
+
+    /// @brief Visit each key-value pair of the src in source order using delimiters known at compile time (see the
+    ///        fixed delimiter parse). Example: for_each_pair<": ", "\r\n", "\r\n\r\n">(src, visitor)
+    /// @tparam KeyDelimiter Delimiter for the key portion (ASCII literal; usable with wide sources)
+    /// @tparam ValueDelimiter The "line terminator" delimiter which defines the value
+    /// @tparam TerminalDelimiter The "end of frame" delimiter which defines the section. Defaults to ""
+    /// @tparam T std::string, std::wstring (any allocator), std::string_view or std::wstring_view; deduced from src
+    /// @tparam F Callable with signature void(view, view) or bool(view, view); returning false stops the scan
+    /// @param src The source buffer; the views passed to the visitor refer to its storage
+    /// @param visitor Invoked for each key-value pair
+    /// @return Number of elements of src consumed
+    template <delimiter_scan::fixed_string KeyDelimiter,
+              delimiter_scan::fixed_string ValueDelimiter,
+              delimiter_scan::fixed_string TerminalDelimiter = "",
+              typename T,
+              typename F>
+    static size_t for_each_pair(const T& src, F&& visitor) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_scannable_v<T>)
+        {
+            using char_t     = typename T::value_type;
+            using delimiters = internal_helpers::static_delimiters<char_t, KeyDelimiter, ValueDelimiter, TerminalDelimiter>;
+
+            internal_helpers::pair_scanner<char_t, delimiters> scanner {delimiters {}};
+            scanner.scan(std::basic_string_view<char_t> {src}, true, std::forward<F>(visitor));
+            return scanner.consumed();
+        }
+
+        throw std::runtime_error("for_each_pair() src must be string, wstring, string_view or wstring_view");
+    }
+
+
+    /// @brief Given a string which contains a key-value pair, extract them into a map of the same type and report where
+    ///        the parse stopped.
+    /// @tparam T Must be either std::string or std::wstring or std::u8string
+    /// @tparam D Destination type: if T is std::string then this may be std::wstring and vice-versa. Defaults to T.
+    /// @tparam R Defaults to std::map but you can use std::multimap if you wish to tackle duplicates in the src string or std::unordered_map
+    ///           Any comparator, hash or allocator may be used (for example std::pmr::map<std::pmr::string, std::pmr::string>).
+    /// @param src Must be either std::string or std::wstring or std::u8string
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value. Defaults to {}
+    /// @param consumed Receives the number of elements of src consumed; the remainder (for example the body following the
+    ///                 headers) starts at this position.
+    /// @return map of key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>>
+    static R parse(const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter, size_t& consumed) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<T, D, R>)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            R resultMap {};
+            internal_helpers::reserve_pairs(resultMap, view_t {src}, view_t {valueDelimiter}, view_t {terminalDelimiter});
+            consumed = for_each_pair(src, keyDelimiter, valueDelimiter, terminalDelimiter, [&](view_t key, view_t value) {
+                internal_helpers::insert_pair<D>(resultMap, key, value);
+            });
+            return resultMap;
+        }
+
+        throw std::runtime_error("parse() src must be string or wstring");
+    }
+
+
     /// @brief Given a string which contains a key-value pair, extract them into a map of the same type.
     /// @tparam T Must be either std::string or std::wstring or std::u8string
     /// @tparam D Destination type: if T is std::string then this may be std::wstring and vice-versa. Defaults to T.
     /// @tparam R Defaults to std::map but you can use std::multimap if you wish to tackle duplicates in the src string or std::unordered_map
+    ///           Any comparator, hash or allocator may be used (for example std::pmr::map<std::pmr::string, std::pmr::string>).
     /// @param src Must be either std::string or std::wstring or std::u8string
     /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
     /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
@@ -105,91 +750,910 @@ namespace siddiqsoft::string2map
     template <typename T, typename D = T, typename R = std::map<D, D>>
     static R parse(const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter = T {}) noexcept(false)
     {
-        if constexpr ((std::is_same_v<T, std::string> || std::is_same_v<T, std::wstring>) &&
-                      (std::is_same_v<D, std::string> || std::is_same_v<D, std::wstring>) &&
-                      ((std::is_same_v<R, std::map<D, D>> || std::is_same_v<R, std::multimap<D, D>> ||
-                        std::is_same_v<R, std::unordered_map<D, D>>)))
+        size_t consumed {};
+        return parse<T, D, R>(src, keyDelimiter, valueDelimiter, terminalDelimiter, consumed);
+    }
+
+
+    /// @brief Given a string which contains a key-value pair, extract them into a map of the same type using delimiters
+    ///        known at compile time. The scanning kernel for each delimiter is selected at compile time (memchr for single
+    ///        element delimiters, a first-element search plus direct compare for two element delimiters such as "\r\n")
+    ///        and no delimiter strings are constructed.
+    ///        Example: parse<": ", "\r\n", "\r\n\r\n">(src, consumed)
+    /// @tparam KeyDelimiter Delimiter for the key portion (ASCII literal; usable with std::wstring sources)
+    /// @tparam ValueDelimiter The "line terminator" delimiter which defines the value
+    /// @tparam TerminalDelimiter The "end of frame" delimiter which defines the section. Defaults to ""
+    /// @tparam T Must be either std::string or std::wstring; deduced from src
+    /// @tparam D Destination type: if T is std::string then this may be std::wstring and vice-versa. Defaults to T.
+    /// @tparam R Defaults to std::map; see parse
+    /// @param src The source string
+    /// @param consumed Receives the number of elements of src consumed
+    /// @return map of key-value elements of given type
+    template <delimiter_scan::fixed_string KeyDelimiter,
+              delimiter_scan::fixed_string ValueDelimiter,
+              delimiter_scan::fixed_string TerminalDelimiter = "",
+              typename T,
+              typename D = T,
+              typename R = std::map<D, D>>
+    static R parse(const T& src, size_t& consumed) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<T, D, R>)
         {
+            using char_t = typename T::value_type;
+            using view_t = std::basic_string_view<char_t>;
+
             R resultMap {};
+            internal_helpers::reserve_pairs(resultMap,
+                                            view_t {src},
+                                            delimiter_scan::fixed_view<char_t, ValueDelimiter>(),
+                                            delimiter_scan::fixed_view<char_t, TerminalDelimiter>());
+            consumed = for_each_pair<KeyDelimiter, ValueDelimiter, TerminalDelimiter>(
+                    src, [&](view_t key, view_t value) { internal_helpers::insert_pair<D>(resultMap, key, value); });
+            return resultMap;
+        }
 
-            // Guard: empty source or empty delimiters yield no results.
-            if (src.empty() || keyDelimiter.empty() || valueDelimiter.empty()) return resultMap;
+        throw std::runtime_error("parse() src must be string or wstring");
+    }
+
+
+    /// @brief Given a string which contains a key-value pair, extract them into a map of the same type using delimiters
+    ///        known at compile time. Example: parse<"=", "&">(src)
+    /// @return map of key-value elements of given type
+    template <delimiter_scan::fixed_string KeyDelimiter,
+              delimiter_scan::fixed_string ValueDelimiter,
+              delimiter_scan::fixed_string TerminalDelimiter = "",
+              typename T,
+              typename D = T,
+              typename R = std::map<D, D>>
+    static R parse(const T& src) noexcept(false)
+    {
+        size_t consumed {};
+        return parse<KeyDelimiter, ValueDelimiter, TerminalDelimiter, T, D, R>(src, consumed);
+    }
+
+
+    /// @brief Given a string which contains a key-value pair, extract them into a map constructed with the given allocator.
+    ///        The keys and values are constructed with the container's allocator (rebound to the string type) so, for
+    ///        example, a std::pmr::map<std::pmr::string, std::pmr::string> is built entirely from one memory resource.
+    /// @tparam T std::string or std::wstring (any allocator)
+    /// @tparam D Destination type: std::string or std::wstring (any allocator, such as std::pmr::string)
+    /// @tparam R std::map, std::multimap or std::unordered_map of <D, D> (any comparator, hash or allocator)
+    /// @param src The source string
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param allocator The allocator for the container (and its elements)
+    /// @return map of key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>>
+    static R parse(const T&                          src,
+                   const T&                          keyDelimiter,
+                   const T&                          valueDelimiter,
+                   const T&                          terminalDelimiter,
+                   const typename R::allocator_type& allocator) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<T, D, R>)
+        {
+            R resultMap(allocator);
+            internal_helpers::parse_to<T, D>(resultMap, src, keyDelimiter, valueDelimiter, terminalDelimiter);
+            return resultMap;
+        }
+
+        throw std::runtime_error("parse() src must be string or wstring");
+    }
 
-            // Limit to the position of the terminalDelimiter.
-            size_t posTerminalDelimiter = !terminalDelimiter.empty() ? src.find(terminalDelimiter) : std::string::npos;
 
-            for (size_t keyStart = 0; keyStart < src.length() && keyStart < posTerminalDelimiter;)
+    /// @brief Clear the given container and refill it from the src, reusing its nodes, string capacity and (for
+    ///        std::unordered_map) bucket array. Intended for long-lived containers such as one per connection.
+    /// @tparam T Must be either std::string or std::wstring (any allocator)
+    /// @tparam D Destination type: std::string or std::wstring (any allocator). Deduced from the container.
+    /// @tparam R std::map, std::multimap or std::unordered_map of <D, D> (any comparator, hash or allocator)
+    /// @param resultMap The container to refill; its previous contents are discarded
+    /// @param src The source string
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param consumed Receives the number of elements of src consumed
+    /// @return Number of key-value pairs inserted (the size of the container)
+    template <typename T, typename R, typename D = typename internal_helpers::destination_of<R>::type>
+    static size_t parse_into(
+            R& resultMap, const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter, size_t& consumed) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<T, D, R>)
+        {
+            consumed = internal_helpers::refill<T, D>(resultMap, src, keyDelimiter, valueDelimiter, terminalDelimiter);
+            return resultMap.size();
+        }
+
+        throw std::runtime_error("parse_into() src must be string or wstring");
+    }
+
+
+    /// @brief Clear the given container and refill it from the src, reusing its nodes, string capacity and (for
+    ///        std::unordered_map) bucket array.
+    /// @param resultMap The container to refill; its previous contents are discarded
+    /// @param src The source string
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Defaults to {}
+    /// @return Number of key-value pairs inserted (the size of the container)
+    template <typename T, typename R, typename D = typename internal_helpers::destination_of<R>::type>
+    static size_t parse_into(R& resultMap, const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter = T {}) noexcept(false)
+    {
+        size_t consumed {};
+        return parse_into<T, R, D>(resultMap, src, keyDelimiter, valueDelimiter, terminalDelimiter, consumed);
+    }
+
+
+    /// @brief Zero-copy variant of parse: the key-value pairs are views into the src and no allocation is performed
+    ///        other than by the destination container itself.
+    /// @tparam T Must be either std::string_view or std::wstring_view
+    /// @tparam R Defaults to std::vector<std::pair<T, T>> (source order, duplicates preserved) but you may use
+    ///           std::map, std::multimap or std::unordered_map of <T, T> (any comparator, hash or allocator)
+    /// @param src The source buffer. It must outlive the returned container as the elements refer to its storage.
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value. Defaults to {}
+    /// @param consumed Receives the number of elements of src consumed
+    /// @return container of key-value views into the src
+    template <typename T, typename R = std::vector<std::pair<T, T>>>
+    static R parse_view(T src, T keyDelimiter, T valueDelimiter, T terminalDelimiter, size_t& consumed) noexcept(false)
+    {
+        if constexpr ((std::is_same_v<T, std::string_view> || std::is_same_v<T, std::wstring_view>) &&
+                      (internal_helpers::is_vector_of<R, T>::value || internal_helpers::is_map_of<R, T>::value))
+        {
+            R resultMap {};
+            internal_helpers::reserve_pairs(resultMap, src, valueDelimiter, terminalDelimiter);
+
+            consumed = for_each_pair(src, keyDelimiter, valueDelimiter, terminalDelimiter, [&](T key, T value) {
+                internal_helpers::emplace_pair(resultMap, key, value);
+            });
+
+            return resultMap;
+        }
+
+        throw std::runtime_error("parse_view() src must be string_view or wstring_view");
+    }
+
+
+    /// @brief Zero-copy variant of parse: the key-value pairs are views into the src and no allocation is performed
+    ///        other than by the destination container itself.
+    /// @tparam T Must be either std::string_view or std::wstring_view
+    /// @tparam R Defaults to std::vector<std::pair<T, T>> (source order, duplicates preserved) but you may use
+    ///           std::map, std::multimap or std::unordered_map of <T, T> (any comparator, hash or allocator)
+    /// @param src The source buffer. It must outlive the returned container as the elements refer to its storage.
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value. Defaults to {}
+    /// @return container of key-value views into the src
+    template <typename T, typename R = std::vector<std::pair<T, T>>>
+    static R parse_view(T src, T keyDelimiter, T valueDelimiter, T terminalDelimiter = T {}) noexcept(false)
+    {
+        size_t consumed {};
+        return parse_view<T, R>(src, keyDelimiter, valueDelimiter, terminalDelimiter, consumed);
+    }
+
+
+    /// @brief Key-value views sorted by key in a fixed-capacity array; the result of parse_literal. It is a literal type
+    ///        so a table parsed during compilation is usable in constant expressions and costs nothing at runtime.
+    ///        As with parse into std::map the pairs iterate in key order and a repeated key keeps its first value.
+    /// @tparam C char or wchar_t
+    /// @tparam N The capacity (the exact number of keys when produced by parse_literal<Src, ...>())
+    template <typename C, size_t N> class literal_map
+    {
+    public:
+        using view_type      = std::basic_string_view<C>;
+        using value_type     = std::pair<view_type, view_type>;
+        using const_iterator = const value_type*;
+        using iterator       = const_iterator;
+
+        constexpr literal_map() noexcept = default;
+
+        /// @brief Insert the pair at its sorted position unless the key is present (as std::map::emplace).
+        /// @return true if the pair was inserted
+        /// @throws std::length_error if the table is full (a compile error during constant evaluation)
+        constexpr bool emplace(view_type key, view_type value)
+        {
+            const size_t pos = lower_bound(key);
+            if (pos < size_ && pairs_[pos].first == key) return false;
+            if (size_ == N) throw std::length_error("literal_map capacity exceeded");
+
+            for (size_t i = size_; i > pos; --i)
+                pairs_[i] = pairs_[i - 1];
+            pairs_[pos] = {key, value};
+            ++size_;
+            return true;
+        }
+
+        /// @return Iterator to the element with the given key or end(); a binary search
+        constexpr const_iterator find(view_type key) const noexcept
+        {
+            const size_t pos = lower_bound(key);
+            return (pos < size_ && pairs_[pos].first == key) ? begin() + pos : end();
+        }
+
+        constexpr bool contains(view_type key) const noexcept { return find(key) != end(); }
+
+        /// @return The value of the given key
+        /// @throws std::out_of_range if the key is not present
+        constexpr view_type at(view_type key) const
+        {
+            if (auto it = find(key); it != end()) return it->second;
+            throw std::out_of_range("literal_map::at key not found");
+        }
+
+        constexpr const_iterator begin() const noexcept { return pairs_.data(); }
+        constexpr const_iterator end() const noexcept { return pairs_.data() + size_; }
+        constexpr size_t         size() const noexcept { return size_; }
+        constexpr bool           empty() const noexcept { return size_ == 0; }
+        static constexpr size_t  capacity() noexcept { return N; }
+
+    private:
+        constexpr size_t lower_bound(view_type key) const noexcept
+        {
+            size_t low = 0, high = size_;
+            while (low < high)
             {
-                if (auto keyEnd = src.find(keyDelimiter, keyStart);
-                    keyEnd != std::string::npos && keyEnd < posTerminalDelimiter)
-                {
-                    // Found a key
-                    T    key      = src.substr(keyStart, keyEnd - keyStart);
-                    // Search for value delimiter, but only up to the terminal delimiter boundary.
-                    auto valueEnd = src.find(valueDelimiter, keyEnd + keyDelimiter.length());
+                const size_t mid = low + (high - low) / 2;
+                if (pairs_[mid].first < key)
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            return low;
+        }
 
-                    // Clamp valueEnd to the terminal delimiter boundary so we don't read past it.
-                    if (valueEnd != std::string::npos && posTerminalDelimiter != std::string::npos &&
-                        valueEnd >= posTerminalDelimiter)
+        std::array<value_type, N> pairs_ {};
+        size_t                    size_ {0};
+    };
+
+
+    namespace internal_helpers
+    {
+        /// @brief The number of key-value pairs parse would visit in src.
+        template <typename C, typename Delimiters> constexpr size_t count_pairs(std::basic_string_view<C> src, Delimiters delimiters)
+        {
+            size_t                      count = 0;
+            pair_scanner<C, Delimiters> scanner {delimiters};
+            scanner.scan(src, true, [&](std::basic_string_view<C>, std::basic_string_view<C>) { ++count; });
+            return count;
+        }
+
+        /// @brief Scan src into a literal_map of the given capacity; usable in constant expressions.
+        template <size_t Capacity, typename C, typename Delimiters>
+        constexpr literal_map<C, Capacity> scan_literal(std::basic_string_view<C> src, Delimiters delimiters)
+        {
+            literal_map<C, Capacity>    result {};
+            pair_scanner<C, Delimiters> scanner {delimiters};
+            scanner.scan(src, true, [&](std::basic_string_view<C> key, std::basic_string_view<C> value) { result.emplace(key, value); });
+            return result;
+        }
+
+        /// @brief The character type of a fixed_string.
+        template <auto S> using fixed_char_t = std::remove_cvref_t<decltype(S.value[0])>;
+    } // namespace internal_helpers
+
+
+    /// @brief Parse a key-value string into a sorted table of views with the semantics of parse into std::map (sorted by
+    ///        key, the first value of a repeated key is kept). The function is constexpr so a literal is parsed during
+    ///        compilation when the result initializes a constexpr variable:
+    ///        constexpr auto defaults = parse_literal<8>("a=1&b=2"sv, "=", "&");
+    /// @tparam Capacity The most keys the table holds; more is a compile error (std::length_error at runtime)
+    /// @tparam C char or wchar_t; deduced from src
+    /// @param src The source. The views refer to its storage so it must outlive the table (a literal always does).
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Defaults to {}
+    /// @return The table of key-value views into src
+    template <size_t Capacity, typename C>
+    static constexpr literal_map<C, Capacity> parse_literal(std::basic_string_view<C>                   src,
+                                                            std::type_identity_t<std::basic_string_view<C>> keyDelimiter,
+                                                            std::type_identity_t<std::basic_string_view<C>> valueDelimiter,
+                                                            std::type_identity_t<std::basic_string_view<C>> terminalDelimiter = {})
+    {
+        return internal_helpers::scan_literal<Capacity>(
+                src, internal_helpers::runtime_delimiters<C> {keyDelimiter, valueDelimiter, terminalDelimiter});
+    }
+
+
+    /// @brief Parse a literal during compilation into a table sized to its number of keys. The source and the delimiters
+    ///        are template arguments so the views refer to static storage. Example:
+    ///        constexpr auto headers = parse_literal<"Accept: */*\r\nHost: example.com\r\n", ": ", "\r\n">();
+    ///        static_assert(headers.at("Host") == "example.com");
+    /// @tparam Src The source literal (char or wchar_t)
+    /// @tparam KeyDelimiter Delimiter for the key portion (ASCII literal; usable with a wide source)
+    /// @tparam ValueDelimiter The "line terminator" delimiter which defines the value
+    /// @tparam TerminalDelimiter The "end of frame" delimiter which defines the section. Defaults to ""
+    /// @return literal_map holding exactly the keys of Src
+    template <delimiter_scan::fixed_string Src,
+              delimiter_scan::fixed_string KeyDelimiter,
+              delimiter_scan::fixed_string ValueDelimiter,
+              delimiter_scan::fixed_string TerminalDelimiter = "">
+    static consteval auto parse_literal()
+    {
+        using char_t     = internal_helpers::fixed_char_t<Src>;
+        using delimiters = internal_helpers::static_delimiters<char_t, KeyDelimiter, ValueDelimiter, TerminalDelimiter>;
+
+        constexpr auto src = delimiter_scan::fixed_view<char_t, Src>();
+        constexpr auto all = internal_helpers::scan_literal<internal_helpers::count_pairs(src, delimiters {})>(src, delimiters {});
+        literal_map<char_t, all.size()> result {};
+        for (const auto& [key, value] : all)
+            result.emplace(key, value);
+        return result;
+    }
+
+
+    /// @brief Parse a literal during compilation into an array of key-value views in source order (duplicates preserved)
+    ///        with the semantics of parse_view. Example: constexpr auto pairs = parse_literal_view<"a=1&b=2", "=", "&">();
+    /// @tparam Src The source literal (char or wchar_t)
+    /// @tparam KeyDelimiter Delimiter for the key portion (ASCII literal; usable with a wide source)
+    /// @tparam ValueDelimiter The "line terminator" delimiter which defines the value
+    /// @tparam TerminalDelimiter The "end of frame" delimiter which defines the section. Defaults to ""
+    /// @return std::array of the pairs of Src
+    template <delimiter_scan::fixed_string Src,
+              delimiter_scan::fixed_string KeyDelimiter,
+              delimiter_scan::fixed_string ValueDelimiter,
+              delimiter_scan::fixed_string TerminalDelimiter = "">
+    static consteval auto parse_literal_view()
+    {
+        using char_t     = internal_helpers::fixed_char_t<Src>;
+        using view_t     = std::basic_string_view<char_t>;
+        using delimiters = internal_helpers::static_delimiters<char_t, KeyDelimiter, ValueDelimiter, TerminalDelimiter>;
+
+        constexpr auto src = delimiter_scan::fixed_view<char_t, Src>();
+        std::array<std::pair<view_t, view_t>, internal_helpers::count_pairs(src, delimiters {})> result {};
+
+        size_t                                             index = 0;
+        internal_helpers::pair_scanner<char_t, delimiters> scanner {delimiters {}};
+        scanner.scan(src, true, [&](view_t key, view_t value) { result[index++] = {key, value}; });
+        return result;
+    }
+
+
+    /// @brief Locate the value of a single key without building a container. The scan stops at the first occurrence of
+    ///        the key (which is the value parse would keep in a std::map) and nothing is allocated.
+    /// @tparam T Must be either std::string_view or std::wstring_view
+    /// @tparam KeyPolicy case_sensitive (default) or case_insensitive key comparison
+    /// @param src The source buffer; the returned view refers to its storage
+    /// @param key The key to locate
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value. Defaults to {}
+    /// @return The value or std::nullopt if the key is not present (before the terminal delimiter)
+    template <typename T, typename KeyPolicy = case_sensitive>
+    static std::optional<T> find_value(T src, T key, T keyDelimiter, T valueDelimiter, T terminalDelimiter = T {}) noexcept(false)
+    {
+        if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::wstring_view>)
+        {
+            std::optional<T> result {};
+            for_each_pair(src, keyDelimiter, valueDelimiter, terminalDelimiter, [&](T k, T v) {
+                if (!KeyPolicy::equal(k, key)) return true;
+                result = v;
+                return false;
+            });
+            return result;
+        }
+
+        throw std::runtime_error("find_value() src must be string_view or wstring_view");
+    }
+
+
+    /// @brief Locate the values of a small set of keys without building a container. The scan stops as soon as every
+    ///        key has been found and nothing is allocated.
+    /// @tparam T Must be either std::string_view or std::wstring_view
+    /// @tparam N Number of keys
+    /// @tparam KeyPolicy case_sensitive (default) or case_insensitive key comparison
+    /// @param src The source buffer; the returned views refer to its storage
+    /// @param keys The keys to locate
+    /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value. Defaults to {}
+    /// @return For each key (in the same order) the value of its first occurrence or std::nullopt
+    template <typename T, size_t N, typename KeyPolicy = case_sensitive>
+    static std::array<std::optional<T>, N>
+    find_values(T src, const std::array<T, N>& keys, T keyDelimiter, T valueDelimiter, T terminalDelimiter = T {}) noexcept(false)
+    {
+        if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::wstring_view>)
+        {
+            std::array<std::optional<T>, N> result {};
+            size_t                          remaining = N;
+            if (remaining == 0) return result;
+
+            for_each_pair(src, keyDelimiter, valueDelimiter, terminalDelimiter, [&](T k, T v) {
+                for (size_t i = 0; i < N; ++i)
+                {
+                    // Only the first occurrence counts; duplicate entries in keys are each filled.
+                    if (!result[i].has_value() && KeyPolicy::equal(k, keys[i]))
                     {
-                        valueEnd = std::string::npos;
+                        result[i] = v;
+                        --remaining;
                     }
+                }
+                return remaining > 0;
+            });
+            return result;
+        }
 
-                    if (!key.empty())
-                    {
-                        // Found value (make sure we skip the key delimiter length)
-                        T value = src.substr(keyEnd + keyDelimiter.length(),
-                                             valueEnd != std::string::npos ? valueEnd - (keyEnd + keyDelimiter.length())
-                                                                           : (posTerminalDelimiter != std::string::npos
-                                                                                      ? posTerminalDelimiter -
-                                                                                                (keyEnd + keyDelimiter.length())
-                                                                                      : std::string::npos));
-
-                        // Check if we need transformation
-                        if constexpr (std::is_same_v<T, std::string> && std::is_same_v<D, std::wstring>)
-                        {
-                            // Insert element.. from string to wstring
-                            resultMap.insert(std::pair {internal_helpers::n2w(key), internal_helpers::n2w(value)});
-                        }
-                        else if constexpr (std::is_same_v<T, std::wstring> && std::is_same_v<D, std::string>)
+        throw std::runtime_error("find_values() src must be string_view or wstring_view");
+    }
+
+
+    /// @brief Whitespace handling for header style fields performed during the scan (see parse_fields).
+    struct field_options
+    {
+        /// @brief Strip optional whitespace (spaces and tabs) around each key and value
+        bool trim {true};
+        /// @brief Treat a value delimiter followed by a space or tab as an obsolete line fold (obs-fold): the value
+        ///        continues on the next line and each fold becomes a single space when the value is copied
+        bool unfold {true};
+    };
+
+    namespace internal_helpers
+    {
+        template <typename C> constexpr bool is_ows(C c) noexcept { return c == C(' ') || c == C('\t'); }
+
+        /// @brief Slice the optional whitespace (and, when unfolding, the line folds) off both ends of the field.
+        template <typename C>
+        constexpr std::basic_string_view<C> trim_field(std::basic_string_view<C> field, std::basic_string_view<C> fold) noexcept
+        {
+            for (bool again = true; again;)
+            {
+                again = false;
+                while (!field.empty() && is_ows(field.front()))
+                    field.remove_prefix(1);
+                while (!field.empty() && is_ows(field.back()))
+                    field.remove_suffix(1);
+                if (!fold.empty() && field.starts_with(fold))
+                {
+                    field.remove_prefix(fold.size());
+                    again = true;
+                }
+                if (!fold.empty() && field.ends_with(fold))
+                {
+                    field.remove_suffix(fold.size());
+                    again = true;
+                }
+            }
+            return field;
+        }
+
+        /// @brief Append the value to out (of the same character type) replacing each line fold with a single space. As
+        ///        with the obs-fold of RFC 9112 the optional whitespace on both sides of the value delimiter is part of the
+        ///        fold. The runs between folds are appended whole and never exceed the source so out may be reserved for
+        ///        value.size().
+        template <typename S, typename C>
+        static void append_unfolded(S& out, std::basic_string_view<C> value, std::basic_string_view<C> valueDelimiter)
+        {
+            size_t from = 0;
+            for (auto fold = delimiter_scan::find(value, valueDelimiter); fold != value.npos; fold = delimiter_scan::find(value, valueDelimiter, from))
+            {
+                auto end = fold;
+                while (end > from && is_ows(value[end - 1]))
+                    --end;
+                out.append(value.data() + from, end - from).push_back(C(' '));
+                for (from = fold + valueDelimiter.size(); from < value.size() && is_ows(value[from]); ++from)
+                    ;
+            }
+            out.append(value.data() + from, value.size() - from);
+        }
+
+        /// @brief scan_pairs with the field options: folded values are kept whole and the key and value are trimmed.
+        /// @tparam F Callable with signature void(view, view, bool) or bool(view, view, bool); the flag is true when
+        ///           the value spans a line fold
+        template <typename C, typename F>
+        static size_t scan_fields(std::basic_string_view<C> src,
+                                  std::basic_string_view<C> keyDelimiter,
+                                  std::basic_string_view<C> valueDelimiter,
+                                  std::basic_string_view<C> terminalDelimiter,
+                                  const field_options&      options,
+                                  F&&                       onPair)
+        {
+            using view_t = std::basic_string_view<C>;
+
+            pair_scanner<C> scanner {keyDelimiter, valueDelimiter, terminalDelimiter, options.unfold};
+            const view_t    fold = options.unfold ? valueDelimiter : view_t {};
+            scanner.scan(src, true, [&](view_t key, view_t value) {
+                if (!options.trim) return onPair(key, value, scanner.folded());
+                return onPair(trim_field(key, view_t {}), trim_field(value, fold), scanner.folded());
+            });
+            return scanner.consumed();
+        }
+    } // namespace internal_helpers
+
+
+    /// @brief Visit each field of a header style src with the optional whitespace around keys and values sliced off and
+    ///        obsolete line folds kept within their value. The views refer to src (a folded value still contains its
+    ///        line breaks; parse_fields replaces them).
+    /// @tparam T std::string, std::wstring (any allocator), std::string_view or std::wstring_view
+    /// @tparam F Callable with signature void(view, view) or bool(view, view); returning false stops the scan
+    /// @param src The source buffer
+    /// @param keyDelimiter Delimiter for the key portion; with trimming ":" accepts both "Key: value" and "Key:value"
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param options Trimming and unfolding
+    /// @param visitor Invoked for each field
+    /// @return Number of elements of src consumed
+    template <typename T, typename F>
+    static size_t
+    for_each_field(const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter, const field_options& options, F&& visitor) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_scannable_v<T>)
+        {
+            using char_t = typename T::value_type;
+            using view_t = std::basic_string_view<char_t>;
+
+            return internal_helpers::scan_fields<char_t>(
+                    view_t {src}, view_t {keyDelimiter}, view_t {valueDelimiter}, view_t {terminalDelimiter}, options, [&](view_t key, view_t value, bool) {
+                        if constexpr (std::is_same_v<std::invoke_result_t<F&, view_t, view_t>, bool>)
+                            return visitor(key, value);
+                        else
+                            visitor(key, value);
+                    });
+        }
+
+        throw std::runtime_error("for_each_field() src must be string, wstring, string_view or wstring_view");
+    }
+
+
+    /// @brief Given a header style string, extract the fields into a map trimming the optional whitespace around each
+    ///        key and value and joining obsolete folded continuation lines, all within the parse scan: each key and
+    ///        value is sliced and then copied once into the destination (a fold becomes a single space).
+    ///        Example: parse_fields(request, ":"s, "\r\n"s, "\r\n\r\n"s, consumed)
+    /// @tparam T Must be either std::string or std::wstring
+    /// @tparam D Destination type: if T is std::string then this may be std::wstring and vice-versa. Defaults to T.
+    /// @tparam R Defaults to std::map; std::multimap, std::unordered_map and flat_header_map are also supported
+    /// @param src The source string
+    /// @param keyDelimiter Delimiter for the key portion; with trimming ":" accepts both "Key: value" and "Key:value"
+    /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+    /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Stop processing if we encounter this value.
+    /// @param consumed Receives the number of elements of src consumed
+    /// @param options Trimming and unfolding (both enabled by default)
+    /// @return map of key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>>
+    static R parse_fields(const T&             src,
+                          const T&             keyDelimiter,
+                          const T&             valueDelimiter,
+                          const T&             terminalDelimiter,
+                          size_t&              consumed,
+                          const field_options& options = {}) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<T, D, R>)
+        {
+            using char_t = typename T::value_type;
+            using view_t = std::basic_string_view<char_t>;
+
+            const view_t vd {valueDelimiter};
+            R            resultMap {};
+            consumed = internal_helpers::scan_fields<char_t>(
+                    view_t {src}, view_t {keyDelimiter}, vd, view_t {terminalDelimiter}, options, [&](view_t key, view_t value, bool folded) {
+                        if (!folded)
                         {
-                            // Insert element.. from wstring to string
-                            resultMap.insert(std::pair {internal_helpers::w2n(key), internal_helpers::w2n(value)});
+                            internal_helpers::insert_pair<D>(resultMap, key, value);
+                            return;
                         }
-                        else if constexpr (std::is_same_v<T, D>)
+
+                        if constexpr (!std::is_same_v<typename D::value_type, char_t>)
                         {
-                            // Transformation not needed; insert element as-is.
-                            resultMap.insert(std::pair {key, value});
+                            // Transcoding reads the joined text
+                            std::basic_string<char_t> joined {};
+                            joined.reserve(value.size());
+                            internal_helpers::append_unfolded(joined, value, vd);
+                            internal_helpers::insert_pair<D>(resultMap, key, view_t {joined});
                         }
-
-                        // Check if we need to advance to next element
-                        if (valueEnd != std::string::npos)
+                        else if constexpr (internal_helpers::is_flat_header_map_of<R, D>::value)
                         {
-                            // Advance to the next potential element.
-                            keyStart = valueEnd + valueDelimiter.length();
+                            // Unfolded straight into the arena
+                            resultMap.emplace_with(key, value.size(), [&](auto& arena) { internal_helpers::append_unfolded(arena, value, vd); });
                         }
                         else
                         {
-                            // Value extends to end of parseable region
-                            break;
+                            const auto alloc = internal_helpers::string_allocator<D>(resultMap);
+                            D          k(alloc);
+                            internal_helpers::assign_to(k, key);
+                            D v(alloc);
+                            v.reserve(value.size());
+                            internal_helpers::append_unfolded(v, value, vd);
+                            resultMap.emplace(std::move(k), std::move(v));
                         }
-                    }
-                    else
-                    {
-                        // Empty key; We must break out of the loop
-                        break;
-                    }
+                    });
+            return resultMap;
+        }
+
+        throw std::runtime_error("parse_fields() src must be string or wstring");
+    }
+
+
+    /// @brief Given a header style string, extract the trimmed and unfolded fields into a map; see parse_fields.
+    /// @return map of key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>>
+    static R parse_fields(const T&             src,
+                          const T&             keyDelimiter,
+                          const T&             valueDelimiter,
+                          const T&             terminalDelimiter = T {},
+                          const field_options& options           = {}) noexcept(false)
+    {
+        size_t consumed {};
+        return parse_fields<T, D, R>(src, keyDelimiter, valueDelimiter, terminalDelimiter, consumed, options);
+    }
+
+
+    namespace internal_helpers
+    {
+        /// @brief The elements percent-decoding rewrites: the '%' of an escape and '+' (a space).
+        template <typename C>
+        inline constexpr delimiter_scan::delimiter_set<C> url_escapes {delimiter_scan::fixed_view<C, delimiter_scan::fixed_string {"%+"}>()};
+
+        /// @return The value of the hexadecimal digit or -1
+        template <typename C> constexpr int hex_value(C c) noexcept
+        {
+            if (c >= C('0') && c <= C('9')) return static_cast<int>(c - C('0'));
+            if (c >= C('a') && c <= C('f')) return static_cast<int>(c - C('a')) + 10;
+            if (c >= C('A') && c <= C('F')) return static_cast<int>(c - C('A')) + 10;
+            return -1;
+        }
+
+        /// @return The byte encoded by the escape "%XX" at src[pos] or -1 if there is no well-formed escape there
+        template <typename C> constexpr int escape_at(std::basic_string_view<C> src, size_t pos) noexcept
+        {
+            if (pos + 2 >= src.size() || src[pos] != C('%')) return -1;
+            const int hi = hex_value(src[pos + 1]);
+            const int lo = hex_value(src[pos + 2]);
+            return (hi < 0 || lo < 0) ? -1 : (hi << 4) | lo;
+        }
+
+        /// @brief Append the percent-decoded src to out: "%XX" becomes the byte XX, '+' a space and a malformed escape
+        ///        is kept as is. The runs between escapes are located with the vectorized find_first_of and appended in
+        ///        one piece. The escaped bytes are UTF-8; for a wide source each run of escapes is transcoded into out one
+        ///        code point at a time. out is reserved for the encoded length, which the decoded text never exceeds.
+        template <typename C, typename S> static void append_url_decoded(std::basic_string_view<C> src, S& out)
+        {
+            out.reserve(out.size() + src.size());
+
+            size_t pos = 0;
+            while (pos < src.size())
+            {
+                const auto at = delimiter_scan::find_first_of(src, url_escapes<C>, pos);
+                if (at == src.npos) break;
+
+                out.append(src.data() + pos, at - pos);
+                pos = at;
+                if (src[pos] == C('+'))
+                {
+                    out.push_back(C(' '));
+                    ++pos;
+                }
+                else if constexpr (std::is_same_v<C, char>)
+                {
+                    const int byte = escape_at(src, pos);
+                    out.push_back(static_cast<char>((byte < 0) ? '%' : byte));
+                    pos += (byte < 0) ? 1 : 3;
                 }
                 else
                 {
-                    // No key end was located (or it's beyond the terminal delimiter); break
-                    break;
+                    size_t escapes = 0;
+                    while (escape_at(src, pos + 3 * escapes) >= 0)
+                        ++escapes;
+
+                    if (escapes == 0)
+                    {
+                        out.push_back(C('%'));
+                        ++pos;
+                    }
+                    for (size_t i = 0; i < escapes;)
+                    {
+                        // A UTF-8 sequence is at most four bytes; gather them from the escapes and decode in place
+                        unsigned char sequence[4] {};
+                        const size_t  available = std::min<size_t>(4, escapes - i);
+                        for (size_t k = 0; k < available; ++k)
+                            sequence[k] = static_cast<unsigned char>(escape_at(src, pos + 3 * (i + k)));
+
+                        char32_t cp = sequence[0];
+                        i += (cp < 0x80) ? 1 : utf::internal_helpers::decode_utf8(sequence, 0, available, cp);
+
+                        wchar_t units[2] {};
+                        out.append(units, utf::internal_helpers::put_wide(units, cp) - units);
+                    }
+                    pos += 3 * escapes;
                 }
             }
+            out.append(src.data() + pos, src.size() - pos);
+        }
+    } // namespace internal_helpers
+
+
+    /// @brief Percent-decode a query string component ("%XX" becomes the byte XX, '+' a space; a malformed escape is
+    ///        kept as is). Nothing is copied when the src contains neither '%' nor '+'.
+    /// @tparam C char or wchar_t; the escaped bytes are UTF-8 (transcoded for wchar_t)
+    /// @param src The encoded text
+    /// @param scratch Receives the decoded text when decoding is required (its contents are replaced and its capacity reused)
+    /// @return src itself when nothing needed decoding, otherwise a view of scratch
+    template <typename C> static std::basic_string_view<C> url_decode(std::basic_string_view<C> src, std::basic_string<C>& scratch)
+    {
+        if (delimiter_scan::find_first_of(src, internal_helpers::url_escapes<C>) == src.npos) return src;
+
+        scratch.clear();
+        internal_helpers::append_url_decoded(src, scratch);
+        return scratch;
+    }
+
+
+    /// @brief Visit each pair of a query string ("key=value&key=value") with the key and value percent-decoded during
+    ///        the scan. The delimiters are "=" and "&" and the parse semantics are those of for_each_pair.
+    /// @tparam T std::string, std::wstring (any allocator), std::string_view or std::wstring_view
+    /// @tparam F Callable with signature void(view, view) or bool(view, view); returning false stops the scan
+    /// @param src The query string (without the leading '?')
+    /// @param visitor Invoked for each decoded pair. A component without escapes is passed as a view of src; a decoded
+    ///                one is a view of a scratch buffer which is only valid until the visitor returns.
+    /// @return Number of elements of src consumed
+    template <typename T, typename F> static size_t for_each_query_pair(const T& src, F&& visitor) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_scannable_v<T>)
+        {
+            using char_t = typename T::value_type;
+            using view_t = std::basic_string_view<char_t>;
+
+            std::basic_string<char_t> keyScratch {};
+            std::basic_string<char_t> valueScratch {};
+            return for_each_pair<"=", "&">(src, [&](view_t key, view_t value) {
+                if constexpr (std::is_same_v<std::invoke_result_t<F&, view_t, view_t>, bool>)
+                    return visitor(url_decode(key, keyScratch), url_decode(value, valueScratch));
+                else
+                    visitor(url_decode(key, keyScratch), url_decode(value, valueScratch));
+            });
+        }
+
+        throw std::runtime_error("for_each_query_pair() src must be string, wstring, string_view or wstring_view");
+    }
+
 
+    /// @brief Given a query string ("tag=networking&order=newest"), extract the percent-decoded key-value pairs into a
+    ///        map. The decoding is fused with the scan: each key and value is decoded straight into the destination
+    ///        string (runs without '%' or '+' are copied whole) so no encoded copy is made and no second pass is needed.
+    /// @tparam T Must be either std::string or std::wstring
+    /// @tparam D Destination type: if T is std::string then this may be std::wstring and vice-versa. Defaults to T.
+    /// @tparam R Defaults to std::map; std::multimap, std::unordered_map and flat_header_map are also supported
+    /// @param src The query string (without the leading '?')
+    /// @param consumed Receives the number of elements of src consumed
+    /// @return map of decoded key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>> static R parse_query(const T& src, size_t& consumed) noexcept(false)
+    {
+        if constexpr (internal_helpers::is_supported_v<T, D, R>)
+        {
+            using char_t = typename T::value_type;
+            using view_t = std::basic_string_view<char_t>;
+
+            R resultMap {};
+            if constexpr (std::is_same_v<typename D::value_type, char_t> && !internal_helpers::is_flat_header_map_of<R, D>::value)
+            {
+                const auto alloc = internal_helpers::string_allocator<D>(resultMap);
+                consumed         = for_each_pair<"=", "&">(src, [&](view_t key, view_t value) {
+                    D k(alloc);
+                    internal_helpers::append_url_decoded(key, k);
+                    D v(alloc);
+                    internal_helpers::append_url_decoded(value, v);
+                    resultMap.emplace(std::move(k), std::move(v));
+                });
+            }
+            else
+            {
+                // Transcoding (or the flat_header_map arena) copies the decoded views
+                consumed = for_each_query_pair(src, [&](view_t key, view_t value) { internal_helpers::insert_pair<D>(resultMap, key, value); });
+            }
             return resultMap;
         }
 
-        throw std::runtime_error("parse() src must be string or wstring");
+        throw std::runtime_error("parse_query() src must be string or wstring");
     }
+
+
+    /// @brief Given a query string, extract the percent-decoded key-value pairs into a map; see parse_query.
+    /// @return map of decoded key-value elements of given type
+    template <typename T, typename D = T, typename R = std::map<D, D>> static R parse_query(const T& src) noexcept(false)
+    {
+        size_t consumed {};
+        return parse_query<T, D, R>(src, consumed);
+    }
+
+
+    /// @brief Incremental parser for input which arrives in pieces (for example HTTP headers read from a socket).
+    ///        Each call to feed() scans only the new data (plus at most a delimiter's length of the previous tail) and
+    ///        adds every completed key-value pair to the result container as soon as it is available. Delimiters which
+    ///        are split across chunks are handled. Only the incomplete tail of the input is retained between calls.
+    /// @tparam T Must be either std::string or std::wstring
+    /// @tparam D Destination type: if T is std::string then this may be std::wstring and vice-versa. Defaults to T.
+    /// @tparam R Defaults to std::map but you can use std::multimap or std::unordered_map
+    template <typename T, typename D = T, typename R = std::map<D, D>> class stream_parser
+    {
+    public:
+        using view_type = std::basic_string_view<typename T::value_type>;
+
+        /// @brief Construct a parser for the given delimiters; same semantics as parse.
+        /// @param keyDelimiter Delimiter for the key portion. Example: ": " or ":" or "="
+        /// @param valueDelimiter The "line terminator" delimiter which defines the value. Example: "\r\n".
+        /// @param terminalDelimiter The "end of frame" delimiter which defines the section. Defaults to {}
+        /// @param allocator The allocator for the result container (and its elements)
+        stream_parser(const T&                          keyDelimiter,
+                      const T&                          valueDelimiter,
+                      const T&                          terminalDelimiter = T {},
+                      const typename internal_helpers::allocator_of<R>::type& allocator = {}) noexcept(false)
+            : keyDelimiter_(keyDelimiter)
+            , valueDelimiter_(valueDelimiter)
+            , terminalDelimiter_(terminalDelimiter)
+            , scanner_(keyDelimiter_, valueDelimiter_, terminalDelimiter_)
+            , result_(internal_helpers::make_container<R>(allocator))
+        {
+            if constexpr (!internal_helpers::is_supported_v<T, D, R>)
+            {
+                throw std::runtime_error("stream_parser src must be string or wstring");
+            }
+        }
+
+        // The scanner refers to the delimiters owned by this object.
+        stream_parser(const stream_parser&)            = delete;
+        stream_parser& operator=(const stream_parser&) = delete;
+
+        /// @brief Append the next piece of input and parse every key-value pair it completes.
+        /// @param chunk The next piece of the input
+        /// @return Number of elements of the chunk consumed. This is the entire chunk unless the terminal delimiter was
+        ///         reached within it; the remainder of the chunk (for example the start of the body) begins at this position.
+        size_t feed(view_type chunk)
+        {
+            if (done()) return 0;
+
+            const size_t pending = buffer_.size();
+            buffer_.append(chunk);
+
+            auto state = scanner_.scan(view_type {buffer_}, false, [&](view_type key, view_type value) {
+                internal_helpers::insert_pair<D>(result_, key, value);
+            });
+
+            if (state != scanner_t::status::need_more)
+            {
+                return scanner_.consumed() > pending ? scanner_.consumed() - pending : 0;
+            }
+
+            // Drop the completed elements; only the incomplete tail is retained.
+            const size_t settled = scanner_.settled();
+            buffer_.erase(0, settled);
+            scanner_.discard(settled);
+            return chunk.size();
+        }
+
+        /// @brief Signal the end of the input. A final element without a trailing value delimiter is parsed (as in parse).
+        void finish()
+        {
+            if (done()) return;
+
+            scanner_.scan(view_type {buffer_}, true, [&](view_type key, view_type value) {
+                internal_helpers::insert_pair<D>(result_, key, value);
+            });
+        }
+
+        /// @brief True once the terminal delimiter has been reached, finish() has been called or the input is malformed.
+        bool done() const noexcept { return scanner_.state() != scanner_t::status::need_more; }
+
+        /// @brief True once the terminal delimiter has been reached.
+        bool terminated() const noexcept { return scanner_.state() == scanner_t::status::terminated; }
+
+        /// @brief The key-value pairs parsed so far.
+        const R& result() const noexcept { return result_; }
+        R&       result() noexcept { return result_; }
+
+        /// @brief Prepare for the next input (for example the next request on the same connection); buffer capacity is kept.
+        void reset()
+        {
+            buffer_.clear();
+            result_.clear();
+            scanner_ = scanner_t {keyDelimiter_, valueDelimiter_, terminalDelimiter_};
+        }
+
+    private:
+        using scanner_t = internal_helpers::pair_scanner<typename T::value_type>;
+
+        T         keyDelimiter_;
+        T         valueDelimiter_;
+        T         terminalDelimiter_;
+        scanner_t scanner_;
+        T         buffer_ {};
+        R         result_;
+    };
 } // namespace siddiqsoft::string2map
@@ -38,12 +38,115 @@
 
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <ranges>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "delimiter_scan.hpp"
+
 
 namespace siddiqsoft::string2vector
 {
+    /// @brief Lazy range of the tokens of a string: each element is a view into the source between runs of delimiters.
+    ///        Leading, trailing and consecutive delimiters are skipped (the same semantics as parse). Tokens are located
+    ///        one at a time as the range is iterated and nothing is allocated so it composes with std::views. The
+    ///        delimiters are prepared once as a delimiter_scan::delimiter_set so each search classifies 16/32 elements at
+    ///        a time instead of comparing each element against every delimiter.
+    ///        Example: for (auto segment : split_view {"/a/b/c/d"sv, "/"sv}) ...
+    /// @tparam C Character type (char or wchar_t)
+    /// @remarks The view refers to the storage of the source and the delimiters which must outlive it.
+    template <typename C> class split_view : public std::ranges::view_interface<split_view<C>>
+    {
+    public:
+        using view_type = std::basic_string_view<C>;
+
+        /// @brief Forward iterator yielding each token; compares equal to std::default_sentinel past the last token.
+        class iterator
+        {
+        public:
+            using iterator_concept  = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = view_type;
+            using difference_type   = std::ptrdiff_t;
+
+            constexpr iterator() noexcept = default;
+
+            constexpr iterator(view_type src, const delimiter_scan::delimiter_set<C>& delimiters, std::size_t from) noexcept
+                : src_(src)
+                , delimiters_(delimiters)
+            {
+                seek(from);
+            }
+
+            constexpr value_type operator*() const noexcept { return src_.substr(tokenStart_, tokenEnd_ - tokenStart_); }
+
+            constexpr iterator& operator++() noexcept
+            {
+                seek(tokenEnd_);
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept
+            {
+                auto previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            constexpr bool operator==(const iterator& other) const noexcept { return tokenStart_ == other.tokenStart_; }
+
+            constexpr bool operator==(std::default_sentinel_t) const noexcept { return tokenStart_ == view_type::npos; }
+
+        private:
+            /// @brief Skip the delimiters at or after from and locate the end of the token which follows.
+            constexpr void seek(std::size_t from) noexcept
+            {
+                tokenStart_ = delimiter_scan::find_first_not_of(src_, delimiters_, from);
+                tokenEnd_   = (tokenStart_ == view_type::npos) ? view_type::npos
+                                                               : delimiter_scan::find_first_of(src_, delimiters_, tokenStart_);
+                if (tokenEnd_ == view_type::npos) tokenEnd_ = src_.size();
+            }
+
+            view_type                        src_ {};
+            delimiter_scan::delimiter_set<C> delimiters_ {};
+            std::size_t                      tokenStart_ {view_type::npos};
+            std::size_t                      tokenEnd_ {view_type::npos};
+        };
+
+        constexpr split_view() noexcept = default;
+
+        /// @brief Tokenize the src on any of the given delimiters.
+        /// @param src The source; the tokens refer to its storage
+        /// @param delimiters The set of delimiter elements (any one of them separates tokens)
+        constexpr split_view(view_type src, view_type delimiters) noexcept
+            : src_(src)
+            , delimiters_(delimiters)
+        {
+        }
+
+        constexpr iterator begin() const noexcept { return iterator {src_, delimiters_, 0}; }
+
+        constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+        /// @brief The source being tokenized.
+        constexpr view_type source() const noexcept { return src_; }
+
+    private:
+        view_type                        src_ {};
+        delimiter_scan::delimiter_set<C> delimiters_ {};
+    };
+
+    template <typename C, typename Tr, typename A>
+    split_view(const std::basic_string<C, Tr, A>&, const std::basic_string<C, Tr, A>&) -> split_view<C>;
+    template <typename C, typename Tr, typename A>
+    split_view(const std::basic_string<C, Tr, A>&, std::basic_string_view<C, Tr>) -> split_view<C>;
+    template <typename C, typename Tr> split_view(std::basic_string_view<C, Tr>, std::basic_string_view<C, Tr>) -> split_view<C>;
+    template <typename C> split_view(const C*, const C*) -> split_view<C>;
+
+
     /// @brief Splits a given string yielding a vector of substrings
     /// @tparam T std::string or std::wstring
     /// @param str The source string
@@ -53,21 +156,18 @@ namespace siddiqsoft::string2vector
     {
         std::vector<T> tokens;
 
-        // Skip delimiters at beginning.
-        auto lastPos = str.find_first_not_of(delimiters, 0);
-        // Find first "non-delimiter".
-        auto pos = str.find_first_of(delimiters, lastPos);
-
-        while ((T::npos != pos) || (T::npos != lastPos))
+        for (auto token : split_view<typename T::value_type> {str, delimiters})
         {
-            // Found a token, add it to the std::vector.
-            tokens.push_back(str.substr(lastPos, pos - lastPos));
-            // Skip delimiters.  Note the "not_of"
-            lastPos = str.find_first_not_of(delimiters, pos);
-            // Find next "non-delimiter"
-            pos = str.find_first_of(delimiters, lastPos);
+            tokens.emplace_back(token);
         }
 
         return tokens;
     }
 } // namespace siddiqsoft::string2vector
+
+
+namespace std::ranges
+{
+    /// @brief The tokens refer to the source (not the view) so they remain valid after the split_view is destroyed.
+    template <typename C> inline constexpr bool enable_borrowed_range<siddiqsoft::string2vector::split_view<C>> = true;
+} // namespace std::ranges
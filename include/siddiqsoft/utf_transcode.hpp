@@ -0,0 +1,426 @@
+/*
+	UTF-8 and wchar_t Transcoding
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIDDIQSOFT_UTF_TRANSCODE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+/// @brief Locale independent conversion between UTF-8 (std::string) and wchar_t strings (UTF-16 where wchar_t is 16 bits
+///        such as Windows, UTF-32 elsewhere).
+/// Each conversion writes directly into the destination string, allocating at most once. Runs of ASCII are copied
+/// 16 elements at a time (SSE2 on x86/x64, 8 at a time with SWAR elsewhere).
+/// Error policy: malformed input never fails the conversion; each maximal invalid subpart of a UTF-8 sequence
+/// (overlong forms, surrogates, values beyond U+10FFFF, truncated sequences or stray continuation bytes) and each unpaired
+/// surrogate (or out of range value) in the wide input is replaced by U+FFFD.
+namespace siddiqsoft::utf
+{
+    inline constexpr char32_t replacement_character = 0xFFFD;
+
+    namespace internal_helpers
+    {
+        inline constexpr bool wide_is_utf16 = sizeof(wchar_t) == 2;
+
+        /// @brief Resize the string without (where supported) initializing the new elements; they are overwritten.
+        template <typename S, typename F> void resize_and_write(S& dst, size_t upperBound, F&& write)
+        {
+#if defined(__cpp_lib_string_resize_and_overwrite)
+            dst.resize_and_overwrite(upperBound, [&](typename S::value_type* out, size_t) { return write(out); });
+#else
+            dst.resize(upperBound);
+            dst.resize(write(dst.data()));
+#endif
+        }
+
+        /// @brief Number of leading ASCII bytes in [s, s + n) examined in blocks; the remainder is left to the caller.
+        ///        The ASCII bytes are widened into out (when not null) as they are verified.
+        inline size_t widen_ascii_block(const char* s, size_t n, wchar_t* out) noexcept
+        {
+            size_t i = 0;
+#if defined(SIDDIQSOFT_UTF_TRANSCODE_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                if (_mm_movemask_epi8(bytes) != 0) break;
+                if (out == nullptr) continue;
+
+                const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+                const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+                if constexpr (wide_is_utf16)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lo);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), hi);
+                }
+                else
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+                }
+            }
+#else
+            for (; i + 8 <= n; i += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, s + i, sizeof(word));
+                if ((word & 0x8080808080808080ull) != 0) break;
+                for (size_t j = 0; out != nullptr && j < 8; ++j)
+                    out[i + j] = static_cast<wchar_t>(static_cast<unsigned char>(s[i + j]));
+            }
+#endif
+            return i;
+        }
+
+        /// @brief Number of leading ASCII elements of [s, s + n) examined in blocks, narrowed into out (when not null) as
+        ///        they are verified.
+        inline size_t narrow_ascii_block(const wchar_t* s, size_t n, char* out) noexcept
+        {
+            size_t i = 0;
+#if defined(SIDDIQSOFT_UTF_TRANSCODE_SSE2)
+            if constexpr (wide_is_utf16)
+            {
+                const __m128i high = _mm_set1_epi16(static_cast<short>(0xFF80));
+                for (; i + 16 <= n; i += 16)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 8));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), high), _mm_setzero_si128())) != 0xFFFF) break;
+                    if (out != nullptr) _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+                }
+            }
+            else
+            {
+                const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFFFF80u));
+                for (; i + 16 <= n; i += 16)
+                {
+                    const __m128i a   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                    const __m128i b   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 4));
+                    const __m128i c   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 8));
+                    const __m128i d   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 12));
+                    const __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, high), _mm_setzero_si128())) != 0xFFFF) break;
+                    // Every value is below 0x80 so the signed saturating pack is exact.
+                    if (out != nullptr)
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+                }
+            }
+#else
+            for (; i + 8 <= n; i += 8)
+            {
+                wchar_t any = 0;
+                for (size_t j = 0; j < 8; ++j)
+                    any |= s[i + j];
+                if (static_cast<std::uint32_t>(any) >= 0x80u) break;
+                for (size_t j = 0; out != nullptr && j < 8; ++j)
+                    out[i + j] = static_cast<char>(s[i + j]);
+            }
+#endif
+            return i;
+        }
+
+        /// @brief Decode one UTF-8 sequence starting at s[i] (which is not ASCII).
+        /// @param cp Receives the code point or U+FFFD for a maximal invalid subpart
+        /// @return Number of bytes consumed (at least 1)
+        inline size_t decode_utf8(const unsigned char* s, size_t i, size_t n, char32_t& cp) noexcept
+        {
+            const unsigned char b0 = s[i];
+            size_t              length {};
+            unsigned char       lo = 0x80, hi = 0xBF; // valid range of the second byte
+
+            if (b0 >= 0xC2 && b0 <= 0xDF)
+            {
+                length = 2;
+                cp     = b0 & 0x1F;
+            }
+            else if (b0 >= 0xE0 && b0 <= 0xEF)
+            {
+                length = 3;
+                cp     = b0 & 0x0F;
+                if (b0 == 0xE0) lo = 0xA0; // overlong
+                if (b0 == 0xED) hi = 0x9F; // surrogates
+            }
+            else if (b0 >= 0xF0 && b0 <= 0xF4)
+            {
+                length = 4;
+                cp     = b0 & 0x07;
+                if (b0 == 0xF0) lo = 0x90; // overlong
+                if (b0 == 0xF4) hi = 0x8F; // beyond U+10FFFF
+            }
+            else
+            {
+                // Continuation byte without a lead, overlong lead (C0/C1) or F5..FF
+                cp = replacement_character;
+                return 1;
+            }
+
+            for (size_t k = 1; k < length; ++k)
+            {
+                const unsigned char b = (i + k < n) ? s[i + k] : 0;
+                if ((i + k >= n) || b < ((k == 1) ? lo : 0x80) || b > ((k == 1) ? hi : 0xBF))
+                {
+                    // The valid prefix is one maximal subpart; the offending byte starts the next sequence.
+                    cp = replacement_character;
+                    return k;
+                }
+                cp = (cp << 6) | (b & 0x3F);
+            }
+            return length;
+        }
+
+        /// @brief Append the code point as one or two wchar_t.
+        inline wchar_t* put_wide(wchar_t* out, char32_t cp) noexcept
+        {
+            if constexpr (wide_is_utf16)
+            {
+                if (cp >= 0x10000)
+                {
+                    cp -= 0x10000;
+                    *out++ = static_cast<wchar_t>(0xD800 + (cp >> 10));
+                    *out++ = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+                    return out;
+                }
+            }
+            *out++ = static_cast<wchar_t>(cp);
+            return out;
+        }
+
+        /// @brief Number of UTF-8 bytes for the code point.
+        constexpr size_t utf8_width(char32_t cp) noexcept
+        {
+            return (cp < 0x80) ? 1 : (cp < 0x800) ? 2 : (cp < 0x10000) ? 3 : 4;
+        }
+
+        /// @brief Append the code point as UTF-8.
+        inline char* put_utf8(char* out, char32_t cp) noexcept
+        {
+            if (cp < 0x80)
+            {
+                *out++ = static_cast<char>(cp);
+            }
+            else if (cp < 0x800)
+            {
+                *out++ = static_cast<char>(0xC0 | (cp >> 6));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000)
+            {
+                *out++ = static_cast<char>(0xE0 | (cp >> 12));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else
+            {
+                *out++ = static_cast<char>(0xF0 | (cp >> 18));
+                *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            return out;
+        }
+
+        /// @brief Decode one code point from the wide input at s[i] (which is not ASCII).
+        /// @return Number of elements consumed (2 for a UTF-16 surrogate pair)
+        inline size_t decode_wide(const wchar_t* s, size_t i, size_t n, char32_t& cp) noexcept
+        {
+            const auto u = static_cast<std::uint32_t>(s[i]);
+            if constexpr (wide_is_utf16)
+            {
+                if (u >= 0xD800 && u <= 0xDBFF && i + 1 < n)
+                {
+                    const auto low = static_cast<std::uint32_t>(s[i + 1]);
+                    if (low >= 0xDC00 && low <= 0xDFFF)
+                    {
+                        cp = 0x10000 + ((u - 0xD800) << 10) + (low - 0xDC00);
+                        return 2;
+                    }
+                }
+            }
+            cp = ((u >= 0xD800 && u <= 0xDFFF) || u > 0x10FFFF) ? replacement_character : static_cast<char32_t>(u);
+            return 1;
+        }
+    } // namespace internal_helpers
+
+
+    /// @brief Exact number of wchar_t utf8_to_wide produces for the source (replacements and surrogate pairs included).
+    ///        ASCII runs are counted 16 elements at a time.
+    inline size_t wide_length(std::string_view src) noexcept
+    {
+        const auto*  s      = reinterpret_cast<const unsigned char*>(src.data());
+        const size_t n      = src.size();
+        size_t       length = 0;
+        size_t       i      = 0;
+        while (i < n)
+        {
+            if (s[i] < 0x80)
+            {
+                const size_t run = internal_helpers::widen_ascii_block(src.data() + i, n - i, nullptr);
+                i += run;
+                length += run;
+                for (; i < n && s[i] < 0x80; ++i)
+                    ++length;
+                continue;
+            }
+
+            char32_t cp;
+            i += internal_helpers::decode_utf8(s, i, n, cp);
+            length += (internal_helpers::wide_is_utf16 && cp >= 0x10000) ? 2 : 1;
+        }
+        return length;
+    }
+
+    /// @brief Convert UTF-8 into the destination wide string (replacing its contents).
+    /// @tparam S std::basic_string<wchar_t> with any allocator
+    /// @param src UTF-8 encoded source
+    /// @param dst Destination; reuses its capacity. Sized up front to the source length, which is never exceeded (a four
+    ///            byte sequence becomes at most a surrogate pair) and is exact for ASCII, so a fresh string is allocated
+    ///            once without a separate counting pass.
+    template <typename S> void utf8_to_wide(std::string_view src, S& dst)
+    {
+        internal_helpers::resize_and_write(dst, src.size(), [&](wchar_t* out) -> size_t {
+            const auto*  s     = reinterpret_cast<const unsigned char*>(src.data());
+            const size_t n     = src.size();
+            wchar_t*     start = out;
+            size_t       i     = 0;
+            while (i < n)
+            {
+                if (s[i] < 0x80)
+                {
+                    const size_t run = internal_helpers::widen_ascii_block(src.data() + i, n - i, out);
+                    i += run;
+                    out += run;
+                    // Scalar up to the non-ASCII byte within the block (or through the tail shorter than a block)
+                    for (; i < n && s[i] < 0x80; ++i)
+                        *out++ = static_cast<wchar_t>(s[i]);
+                    continue;
+                }
+
+                char32_t cp;
+                i += internal_helpers::decode_utf8(s, i, n, cp);
+                out = internal_helpers::put_wide(out, cp);
+            }
+            return static_cast<size_t>(out - start);
+        });
+    }
+
+    /// @brief Exact number of UTF-8 bytes wide_to_utf8 produces for the source (replacements included).
+    ///        ASCII runs are counted 16 elements at a time.
+    inline size_t utf8_length(std::wstring_view src) noexcept
+    {
+        const wchar_t* s      = src.data();
+        const size_t   n      = src.size();
+        size_t         length = 0;
+        size_t         i      = 0;
+        while (i < n)
+        {
+            if (static_cast<std::uint32_t>(s[i]) < 0x80u)
+            {
+                const size_t run = internal_helpers::narrow_ascii_block(s + i, n - i, nullptr);
+                i += run;
+                length += run;
+                for (; i < n && static_cast<std::uint32_t>(s[i]) < 0x80u; ++i)
+                    ++length;
+                continue;
+            }
+
+            char32_t cp;
+            i += internal_helpers::decode_wide(s, i, n, cp);
+            length += internal_helpers::utf8_width(cp);
+        }
+        return length;
+    }
+
+    /// @brief Convert the wide string into UTF-8 in the destination string (replacing its contents).
+    /// @tparam S std::basic_string<char> with any allocator
+    /// @param src UTF-16 or UTF-32 (per the size of wchar_t) source
+    /// @param dst Destination; reuses its capacity. Sized exactly (see utf8_length) before it is written so a fresh
+    ///            string is allocated once and without the 3-4x slack of the worst case bound.
+    template <typename S> void wide_to_utf8(std::wstring_view src, S& dst)
+    {
+        internal_helpers::resize_and_write(dst, utf8_length(src), [&](char* out) -> size_t {
+            const wchar_t* s     = src.data();
+            const size_t   n     = src.size();
+            char*          start = out;
+            size_t         i     = 0;
+            while (i < n)
+            {
+                if (static_cast<std::uint32_t>(s[i]) < 0x80u)
+                {
+                    const size_t run = internal_helpers::narrow_ascii_block(s + i, n - i, out);
+                    i += run;
+                    out += run;
+                    for (; i < n && static_cast<std::uint32_t>(s[i]) < 0x80u; ++i)
+                        *out++ = static_cast<char>(s[i]);
+                    continue;
+                }
+
+                char32_t cp;
+                i += internal_helpers::decode_wide(s, i, n, cp);
+                out = internal_helpers::put_utf8(out, cp);
+            }
+            return static_cast<size_t>(out - start);
+        });
+    }
+
+    /// @brief Convert UTF-8 to a std::wstring.
+    inline std::wstring to_wide(std::string_view src)
+    {
+        std::wstring result;
+        utf8_to_wide(src, result);
+        return result;
+    }
+
+    /// @brief Convert a std::wstring (UTF-16 or UTF-32) to UTF-8.
+    inline std::string to_utf8(std::wstring_view src)
+    {
+        std::string result;
+        wide_to_utf8(src, result);
+        return result;
+    }
+} // namespace siddiqsoft::utf
@@ -0,0 +1,233 @@
+/*
+	Well-Known Header Table
+
+	Version 1.0.0
+
+	https://github.com/siddiqsoftware/string2map/
+
+	BSD 3-Clause License
+
+	Copyright (c) 2003-2020, Abdelkareem Siddiq, Siddiq Software LLC.
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived from
+	this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "case_insensitive.hpp"
+
+
+namespace siddiqsoft::string2map
+{
+    /// @brief The well-known HTTP header names recognized by well_known_headers (in the order of its names).
+    enum class header_id : std::uint8_t
+    {
+        accept,
+        accept_encoding,
+        accept_language,
+        authorization,
+        cache_control,
+        connection,
+        content_encoding,
+        content_length,
+        content_type,
+        cookie,
+        date,
+        etag,
+        expect,
+        host,
+        if_modified_since,
+        if_none_match,
+        last_modified,
+        location,
+        origin,
+        referer,
+        server,
+        set_cookie,
+        transfer_encoding,
+        upgrade,
+        user_agent,
+        x_forwarded_for
+    };
+
+
+    namespace internal_helpers
+    {
+        /// @brief Hash of the length and the first, middle and last elements (ASCII folded) of a key. It is cheap enough
+        ///        to evaluate for every key and, with a seed chosen at compile time, collision free for a small set of keys.
+        template <typename C> constexpr std::uint32_t sample_hash(std::uint32_t seed, std::basic_string_view<C> key) noexcept
+        {
+            if (key.empty()) return seed;
+
+            std::uint32_t h = seed ^ static_cast<std::uint32_t>(key.size());
+            for (const C ch : {key.front(), key[key.size() / 2], key.back()})
+                h = (h ^ static_cast<std::uint32_t>(fold_ascii(ch))) * 16777619u;
+            return h ^ (h >> 15);
+        }
+
+        /// @brief Search for the first seed which maps every key to its own slot of a table of Slots entries.
+        /// @return The seed or 0 if none was found (the keys share their length and sampled elements)
+        template <size_t Slots, size_t Count>
+        constexpr std::uint32_t perfect_hash_seed(const std::array<std::string_view, Count>& keys) noexcept
+        {
+            for (std::uint32_t seed = 1; seed < 100000; ++seed)
+            {
+                std::array<bool, Slots> used {};
+                bool                    unique = true;
+                for (size_t i = 0; i < Count && unique; ++i)
+                {
+                    const auto slot = sample_hash(seed, keys[i]) % Slots;
+                    unique          = !used[slot];
+                    used[slot]      = true;
+                }
+                if (unique) return seed;
+            }
+            return 0;
+        }
+    } // namespace internal_helpers
+
+
+    /// @brief Compile-time perfect hash table of the well-known HTTP header names. A key is recognized with one hash of its
+    ///        length and three of its elements, one table load and one comparison against the canonical name, so the
+    ///        lookup is cheap enough to perform for every key parsed. Used as the KnownKeys parameter of flat_header_map,
+    ///        which then keeps the canonical spelling of a recognized key as a static view (the key is not copied) and
+    ///        finds its first occurrence in O(1) with get(header_id).
+    struct well_known_headers
+    {
+        using id_type = header_id;
+
+        /// @brief The canonical spelling of each header; indexed by header_id.
+        static constexpr std::array<std::string_view, 26> names {"Accept",
+                                                                 "Accept-Encoding",
+                                                                 "Accept-Language",
+                                                                 "Authorization",
+                                                                 "Cache-Control",
+                                                                 "Connection",
+                                                                 "Content-Encoding",
+                                                                 "Content-Length",
+                                                                 "Content-Type",
+                                                                 "Cookie",
+                                                                 "Date",
+                                                                 "ETag",
+                                                                 "Expect",
+                                                                 "Host",
+                                                                 "If-Modified-Since",
+                                                                 "If-None-Match",
+                                                                 "Last-Modified",
+                                                                 "Location",
+                                                                 "Origin",
+                                                                 "Referer",
+                                                                 "Server",
+                                                                 "Set-Cookie",
+                                                                 "Transfer-Encoding",
+                                                                 "Upgrade",
+                                                                 "User-Agent",
+                                                                 "X-Forwarded-For"};
+
+        static constexpr size_t        count = names.size();
+        static constexpr size_t        slots = 64;
+        static constexpr std::uint32_t seed  = internal_helpers::perfect_hash_seed<slots>(names);
+        static_assert(seed != 0, "well_known_headers: no perfect hash seed for the names");
+
+        /// @brief The index of the name in each slot or count for an empty slot.
+        static constexpr std::array<std::uint8_t, slots> table = [] {
+            std::array<std::uint8_t, slots> result {};
+            result.fill(static_cast<std::uint8_t>(count));
+            for (size_t i = 0; i < count; ++i)
+                result[internal_helpers::sample_hash(seed, names[i]) % slots] = static_cast<std::uint8_t>(i);
+            return result;
+        }();
+
+        /// @brief Recognize the key, comparing it with the canonical name through the key policy (so with case_insensitive
+        ///        "content-length" is recognized as Content-Length).
+        /// @return The index of the name or count if the key is not well-known
+        template <typename KeyPolicy, typename C> static constexpr size_t lookup(std::basic_string_view<C> key) noexcept
+        {
+            const size_t index = table[internal_helpers::sample_hash(seed, key) % slots];
+            return (index != count && KeyPolicy::equal(name<C>(index), key)) ? index : count;
+        }
+
+        /// @brief The canonical name in the character type C; wide names refer to static storage built at compile time.
+        template <typename C> static constexpr std::basic_string_view<C> name(size_t index) noexcept
+        {
+            if constexpr (std::is_same_v<C, char>)
+                return names[index];
+            else
+                return {storage<C>.data() + offsets[index], names[index].size()};
+        }
+
+        /// @brief The key_hash of each name under the key policy (the hash flat_header_map stores for the key).
+        template <typename KeyPolicy> static constexpr std::uint32_t hash(size_t index) noexcept { return hashes<KeyPolicy>[index]; }
+
+    private:
+        static constexpr std::array<size_t, count> offsets = [] {
+            std::array<size_t, count> result {};
+            for (size_t i = 1; i < count; ++i)
+                result[i] = result[i - 1] + names[i - 1].size();
+            return result;
+        }();
+
+        template <typename C>
+        static constexpr std::array<C, offsets[count - 1] + names[count - 1].size()> storage = [] {
+            std::array<C, offsets[count - 1] + names[count - 1].size()> result {};
+            for (size_t i = 0; i < count; ++i)
+            {
+                for (size_t j = 0; j < names[i].size(); ++j)
+                    result[offsets[i] + j] = static_cast<C>(names[i][j]);
+            }
+            return result;
+        }();
+
+        template <typename KeyPolicy> static constexpr std::array<std::uint32_t, count> hashes = [] {
+            std::array<std::uint32_t, count> result {};
+            for (size_t i = 0; i < count; ++i)
+                result[i] = key_hash<KeyPolicy>(names[i]);
+            return result;
+        }();
+    };
+
+
+    /// @brief KnownKeys parameter of flat_header_map which recognizes no keys (the default): every key is copied.
+    struct no_known_keys
+    {
+        enum class id_type : std::uint8_t
+        {
+        };
+
+        static constexpr size_t count = 0;
+
+        template <typename KeyPolicy, typename C> static constexpr size_t lookup(std::basic_string_view<C>) noexcept { return count; }
+        template <typename C> static constexpr std::basic_string_view<C> name(size_t) noexcept { return {}; }
+        template <typename KeyPolicy> static constexpr std::uint32_t hash(size_t) noexcept { return 0; }
+    };
+} // namespace siddiqsoft::string2map
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../include/siddiqsoft/delimiter_scan.hpp"
+
+
+namespace siddiqsoft::delimiter_scan
+{
+    namespace
+    {
+        /// @brief Build a pseudo-random buffer over a tiny alphabet so that delimiters and near-misses are frequent.
+        template <typename T> T random_text(std::mt19937& rng, size_t length)
+        {
+            static constexpr char alphabet[] = "ab:\r\n =&";
+            std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+            T                                     text;
+            for (size_t i = 0; i < length; ++i)
+                text.push_back(static_cast<typename T::value_type>(alphabet[pick(rng)]));
+            return text;
+        }
+
+        /// @brief The kernels which may be invoked on this cpu.
+        std::vector<simd_level> supported_levels()
+        {
+            std::vector<simd_level> levels {simd_level::scalar};
+            if (supported_level() >= simd_level::sse2) levels.push_back(simd_level::sse2);
+            if (supported_level() >= simd_level::avx2) levels.push_back(simd_level::avx2);
+            return levels;
+        }
+
+        /// @brief Compare every kernel supported on this cpu against std::basic_string_view::find.
+        template <typename T> void expect_kernels_match(const T& src, const T& needle)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            for (size_t from = 0; from <= src.size() + 1; ++from)
+            {
+                const auto expected = view_t {src}.find(view_t {needle}, from);
+                for (auto level : supported_levels())
+                {
+                    ASSERT_EQ(expected, delimiter_scan::find(view_t {src}, view_t {needle}, from, level))
+                            << "level " << static_cast<int>(level) << " from " << from << " needle length " << needle.size();
+                }
+            }
+        }
+    } // namespace
+
+
+    TEST(delimiter_scan, find_string_matches_scalar)
+    {
+        std::mt19937 rng {20240501};
+
+        for (size_t length : {0u, 1u, 7u, 15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 100u, 257u})
+        {
+            const auto src = random_text<std::string>(rng, length);
+            for (std::string needle : {":", "\r\n", ": ", "\r\n\r\n", "&", "ab:", "zz", "a"})
+                expect_kernels_match(src, needle);
+        }
+    }
+
+    TEST(delimiter_scan, find_wstring_matches_scalar)
+    {
+        std::mt19937 rng {20240502};
+
+        for (size_t length : {0u, 1u, 3u, 4u, 5u, 7u, 8u, 9u, 15u, 16u, 17u, 63u, 100u})
+        {
+            const auto src = random_text<std::wstring>(rng, length);
+            for (std::wstring needle : {L":", L"\r\n", L": ", L"\r\n\r\n", L"&", L"ab:", L"zz"})
+                expect_kernels_match(src, needle);
+        }
+    }
+
+    TEST(delimiter_scan, find_wide_characters_beyond_ascii)
+    {
+        // Make sure the element-wise compare does not match on partial (byte) equality of wide characters.
+        std::wstring src    = L"਍ഊ഍ਊ\r\n ";
+        std::wstring needle = L"\r\n";
+        for (auto level : supported_levels())
+            EXPECT_EQ(4u, delimiter_scan::find(std::wstring_view {src}, std::wstring_view {needle}, 0, level));
+    }
+
+    TEST(delimiter_scan, find_long_buffer)
+    {
+        // A multi-kilobyte header block with the terminal delimiter near the end.
+        std::string src;
+        for (int i = 0; i < 200; ++i)
+            src += "X-Header-" + std::to_string(i) + ": some value\r\n";
+        src += "\r\nbody";
+
+        EXPECT_EQ(src.find("\r\n\r\n"), delimiter_scan::find(std::string_view {src}, std::string_view {"\r\n\r\n"}));
+        EXPECT_EQ(std::string_view::npos, delimiter_scan::find(std::string_view {src}, std::string_view {"\r\n\r\n\r\n"}));
+    }
+
+    TEST(delimiter_scan, find_constexpr)
+    {
+        static_assert(delimiter_scan::find(std::string_view {"a=1&b=2"}, std::string_view {"&"}) == 3);
+        static_assert(delimiter_scan::find(std::wstring_view {L"a=1&b=2"}, std::wstring_view {L"b="}, 1) == 4);
+        SUCCEED();
+    }
+
+    TEST(delimiter_scan, count_matches_scalar)
+    {
+        std::mt19937 rng {20240503};
+
+        for (size_t length : {0u, 1u, 15u, 16u, 17u, 33u, 64u, 100u, 257u, 1000u})
+        {
+            const auto src  = random_text<std::string>(rng, length);
+            const auto wsrc = random_text<std::wstring>(rng, length);
+            for (std::string_view needle : {"&", "\r\n", "aa", "&&&", "\r\n\r\n", "ab:", "zz"})
+            {
+                const std::wstring      wstorage(needle.begin(), needle.end());
+                const std::wstring_view wneedle {wstorage};
+                for (size_t from : {size_t {0}, size_t {5}, length})
+                {
+                    const auto expected  = internal_helpers::count_scalar(std::string_view {src}, needle, from);
+                    const auto wexpected = internal_helpers::count_scalar(std::wstring_view {wsrc}, wneedle, from);
+                    for (auto level : supported_levels())
+                    {
+                        ASSERT_EQ(expected, delimiter_scan::count(std::string_view {src}, needle, from, level))
+                                << "level " << static_cast<int>(level) << " length " << length << " needle " << needle;
+                        ASSERT_EQ(wexpected, delimiter_scan::count(std::wstring_view {wsrc}, wneedle, from, level))
+                                << "level " << static_cast<int>(level) << " length " << length << " needle " << needle;
+                    }
+                }
+            }
+        }
+
+        // Overlapping occurrences are counted as find steps over them.
+        std::string run(100, '&');
+        for (auto level : supported_levels())
+        {
+            EXPECT_EQ(33u, delimiter_scan::count(std::string_view {run}, std::string_view {"&&&"}, 0, level));
+            EXPECT_EQ(0u, delimiter_scan::count(std::string_view {run}, std::string_view {}, 0, level));
+        }
+        static_assert(delimiter_scan::count(std::string_view {"a=1&b=2&c=3"}, std::string_view {"&"}) == 2);
+    }
+
+
+    TEST(delimiter_scan, find_either_matches_scalar)
+    {
+        std::mt19937 rng {20240503};
+
+        const std::vector<std::pair<std::string, std::string>> needles {
+                {"\r\n\r\n", ": "}, {"\r\n\r\n", "\r\n"}, {"|||", "&"}, {"\r\n", "\r\n"}, {"a", "ab:"}, {"", "&"}, {"=", ""}};
+
+        for (size_t length : {0u, 1u, 5u, 16u, 31u, 32u, 33u, 65u, 200u})
+        {
+            const auto src = random_text<std::string>(rng, length);
+            for (const auto& [first, second] : needles)
+            {
+                for (size_t firstFrom = 0; firstFrom <= length; firstFrom += 3)
+                {
+                    for (size_t secondFrom = 0; secondFrom <= length; secondFrom += 5)
+                    {
+                        // Reference: two independent searches and the earliest wins (first on a tie).
+                        const auto a = first.empty() ? std::string::npos : src.find(first, firstFrom);
+                        const auto b = second.empty() ? std::string::npos : src.find(second, secondFrom);
+                        match      expected {};
+                        if (a != std::string::npos && (b == std::string::npos || a <= b))
+                            expected = {a, 0};
+                        else if (b != std::string::npos)
+                            expected = {b, 1};
+
+                        for (auto level : supported_levels())
+                        {
+                            auto result = delimiter_scan::find_either(
+                                    std::string_view {src}, std::string_view {first}, firstFrom, std::string_view {second}, secondFrom, level);
+                            ASSERT_EQ(expected.position, result.position) << "level " << static_cast<int>(level);
+                            ASSERT_EQ(expected.needle, result.needle) << "level " << static_cast<int>(level);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(delimiter_scan, find_either_wstring)
+    {
+        std::mt19937 rng {20240504};
+
+        for (size_t length : {0u, 3u, 8u, 9u, 17u, 64u, 129u})
+        {
+            const auto src = random_text<std::wstring>(rng, length);
+            for (size_t from = 0; from <= length; ++from)
+            {
+                const auto a        = src.find(L"\r\n\r\n", from);
+                const auto b        = src.find(L": ", from);
+                const auto expected = std::min(a, b);
+                for (auto level : supported_levels())
+                {
+                    auto result = delimiter_scan::find_either(
+                            std::wstring_view {src}, std::wstring_view {L"\r\n\r\n"}, from, std::wstring_view {L": "}, from, level);
+                    ASSERT_EQ(expected, result.position);
+                    if (result.found())
+                    {
+                        ASSERT_EQ(a == expected ? 0u : 1u, result.needle);
+                    }
+                }
+            }
+        }
+    }
+    namespace
+    {
+        template <fixed_string Needle, typename T> void expect_fixed_matches(const T& src)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            const auto needle = fixed_view<typename T::value_type, Needle>();
+            for (size_t from = 0; from <= src.size() + 1; ++from)
+            {
+                ASSERT_EQ(view_t {src}.find(needle, from), find_fixed<Needle>(view_t {src}, from)) << "from " << from << " length " << src.size();
+            }
+        }
+
+        template <fixed_string First, fixed_string Second, typename T> void expect_either_fixed_matches(const T& src)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            const auto first  = fixed_view<typename T::value_type, First>();
+            const auto second = fixed_view<typename T::value_type, Second>();
+            for (size_t firstFrom = 0; firstFrom <= src.size(); firstFrom += 3)
+            {
+                for (size_t secondFrom = 0; secondFrom <= src.size(); ++secondFrom)
+                {
+                    const auto expected = find_either(view_t {src}, first, firstFrom, second, secondFrom, simd_level::scalar);
+                    const auto actual   = find_either_fixed<First, Second>(view_t {src}, firstFrom, secondFrom);
+                    ASSERT_EQ(expected.position, actual.position) << firstFrom << "/" << secondFrom;
+                    ASSERT_EQ(expected.needle, actual.needle) << firstFrom << "/" << secondFrom;
+                }
+            }
+        }
+    } // namespace
+
+
+    TEST(delimiter_scan, find_fixed_matches_scalar)
+    {
+        std::mt19937 rng {20240610};
+
+        for (size_t length : {0u, 1u, 2u, 5u, 16u, 33u, 100u, 257u})
+        {
+            const auto src  = random_text<std::string>(rng, length);
+            const auto wsrc = random_text<std::wstring>(rng, length);
+            expect_fixed_matches<"&">(src);
+            expect_fixed_matches<"\r\n">(src);
+            expect_fixed_matches<": ">(src);
+            expect_fixed_matches<"\r\n\r\n">(src);
+            expect_fixed_matches<"">(src);
+            expect_fixed_matches<"=">(wsrc);
+            expect_fixed_matches<"\r\n">(wsrc);
+            expect_fixed_matches<L"\r\n\r\n">(wsrc);
+        }
+
+        static_assert(find_fixed<"&">(std::string_view {"a=1&b=2"}) == 3);
+        static_assert(find_fixed<"b=">(std::wstring_view {L"a=1&b=2"}, 1) == 4);
+        static_assert(find_fixed<"\r\n">(std::string_view {"a\rb\r\n"}) == 3);
+    }
+
+    TEST(delimiter_scan, find_either_fixed_matches_scalar)
+    {
+        std::mt19937 rng {20240611};
+
+        for (size_t length : {0u, 1u, 4u, 17u, 64u})
+        {
+            const auto src  = random_text<std::string>(rng, length);
+            const auto wsrc = random_text<std::wstring>(rng, length);
+            // The terminal begins with the value delimiter: single scan
+            expect_either_fixed_matches<"\r\n\r\n", "\r\n">(src);
+            expect_either_fixed_matches<"&&", "&">(src);
+            // Unrelated delimiters
+            expect_either_fixed_matches<"\r\n\r\n", ": ">(src);
+            expect_either_fixed_matches<"", "=">(src);
+            expect_either_fixed_matches<"\r\n", "">(src);
+            expect_either_fixed_matches<"\r\n\r\n", "\r\n">(wsrc);
+            expect_either_fixed_matches<"\r\n\r\n", ":">(wsrc);
+        }
+    }
+
+    namespace
+    {
+        /// @brief Compare every delimiter set kernel supported on this cpu against find_first_of/find_first_not_of.
+        template <typename T> void expect_set_kernels_match(const T& src, const T& delimiters)
+        {
+            using view_t = std::basic_string_view<typename T::value_type>;
+
+            const delimiter_set<typename T::value_type> set {view_t {delimiters}};
+            for (size_t from = 0; from <= src.size() + 1; ++from)
+            {
+                const auto expectedOf    = view_t {src}.find_first_of(view_t {delimiters}, from);
+                const auto expectedNotOf = view_t {src}.find_first_not_of(view_t {delimiters}, from);
+                for (auto level : supported_levels())
+                {
+                    ASSERT_EQ(expectedOf, find_first_of(view_t {src}, set, from, level))
+                            << "level " << static_cast<int>(level) << " from " << from << " set size " << delimiters.size();
+                    ASSERT_EQ(expectedNotOf, find_first_not_of(view_t {src}, set, from, level))
+                            << "level " << static_cast<int>(level) << " from " << from << " set size " << delimiters.size();
+                }
+            }
+        }
+
+        /// @brief Random elements drawn from the whole range of the character type (biased towards the delimiters).
+        template <typename T> T random_elements(std::mt19937& rng, size_t length, const T& favoured, unsigned limit)
+        {
+            std::uniform_int_distribution<unsigned> pick(0, limit);
+            T                                       text;
+            for (size_t i = 0; i < length; ++i)
+            {
+                const unsigned value = pick(rng);
+                text.push_back((value % 3 == 0 && !favoured.empty()) ? favoured[value % favoured.size()]
+                                                                     : static_cast<typename T::value_type>(value));
+            }
+            return text;
+        }
+    } // namespace
+
+
+    TEST(delimiter_scan, delimiter_set_matches_scalar)
+    {
+        using namespace std::string_literals;
+
+        std::mt19937 rng {20240701};
+
+        std::string everyByte {};
+        for (int c = 0; c < 256; ++c)
+            everyByte.push_back(static_cast<char>(c));
+
+        const std::vector<std::string> sets {""s,
+                                             ","s,
+                                             "\r\n"s,
+                                             " \t,;"s,
+                                             "/?#&=+;:@"s,
+                                             "\x80\xff\x7f\x00\x01"s,
+                                             "0123456789abcdefABCDEF \t\r\n"s,
+                                             everyByte.substr(1, 200),
+                                             everyByte};
+        for (size_t length : {0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 64u, 100u, 257u})
+        {
+            for (const auto& delimiters : sets)
+            {
+                expect_set_kernels_match(random_elements<std::string>(rng, length, delimiters, 255), delimiters);
+                expect_set_kernels_match(random_text<std::string>(rng, length), delimiters);
+            }
+        }
+
+        // Long runs of delimiters and of non-delimiters
+        expect_set_kernels_match(std::string(300, ',') + "x" + std::string(70, ';'), " ,;"s);
+        expect_set_kernels_match(std::string(300, 'x') + "," + std::string(70, 'y'), " ,;"s);
+
+        static_assert(find_first_of(std::string_view {"a b,c"}, delimiter_set<char> {" ,"}, 2) == 3);
+        static_assert(find_first_not_of(std::string_view {"  ,x"}, delimiter_set<char> {" ,"}) == 3);
+    }
+
+    TEST(delimiter_scan, delimiter_set_wstring)
+    {
+        using namespace std::string_literals;
+
+        std::mt19937 rng {20240702};
+
+        const std::vector<std::wstring> sets {L""s,
+                                              L"\r\n"s,
+                                              L" \t,;"s,
+                                              L"\u00a0\u2002\u3000 "s,
+                                              L"\u00ff\u0100\u01ff\u0200 ,;:\t\r\n\U00010000"s,
+                                              L"abcdefghijklmnop"s};
+        for (size_t length : {0u, 1u, 7u, 8u, 9u, 33u, 100u})
+        {
+            for (const auto& delimiters : sets)
+            {
+                expect_set_kernels_match(random_elements<std::wstring>(rng, length, delimiters, 0x10100), delimiters);
+                expect_set_kernels_match(random_text<std::wstring>(rng, length), delimiters);
+            }
+        }
+    }
+} // namespace siddiqsoft::delimiter_scan
@@ -0,0 +1,212 @@
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <version>
+
+#include "gtest/gtest.h"
+
+#include "../include/siddiqsoft/string2map.hpp"
+
+
+namespace siddiqsoft::string2map
+{
+    TEST(flat_header_map, emplace_find_and_duplicates)
+    {
+        using namespace std;
+
+        flat_header_map<char, 4> headers {};
+        EXPECT_TRUE(headers.empty());
+        headers.emplace("Host"sv, "www.example.com"sv);
+        headers.emplace("Accept"sv, "*/*"sv);
+        headers.emplace("Host"sv, "duplicate"sv);
+
+        EXPECT_EQ(3, headers.size());
+        EXPECT_EQ("www.example.com", headers.at("Host"));
+        EXPECT_EQ(2, headers.count("Host"));
+        EXPECT_TRUE(headers.contains("Accept"));
+        EXPECT_FALSE(headers.contains("accept"));
+        EXPECT_FALSE(headers.contains("Hos"));
+        EXPECT_EQ(headers.end(), headers.find("Missing"));
+        EXPECT_THROW(headers.at("Missing"), std::out_of_range);
+        EXPECT_EQ("Host" "www.example.com" "Accept" "*/*" "Host" "duplicate", headers.arena());
+
+        // Iteration is in insertion order
+        std::vector<std::pair<string_view, string_view>> items(headers.begin(), headers.end());
+        ASSERT_EQ(3, items.size());
+        EXPECT_EQ("duplicate", items[2].second);
+    }
+
+    TEST(flat_header_map, spills_beyond_inline_capacity)
+    {
+        using namespace std;
+
+        flat_header_map<char, 2> headers {};
+        for (int i = 0; i < 40; ++i)
+            headers.emplace("Key-" + to_string(i), "Value-" + to_string(i));
+
+        ASSERT_EQ(40, headers.size());
+        for (int i = 0; i < 40; ++i)
+            EXPECT_EQ("Value-" + to_string(i), headers.at("Key-" + to_string(i)));
+        EXPECT_EQ(40, std::distance(headers.begin(), headers.end()));
+
+        // Copies refer to their own arena
+        auto copy = headers;
+        headers.clear();
+        EXPECT_TRUE(headers.empty());
+        EXPECT_EQ("Value-39", copy.at("Key-39"));
+    }
+
+    TEST(flat_header_map, parse_target)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        size_t consumed {};
+        auto   headers = siddiqsoft::string2map::parse<string, string, flat_header_map<char>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s, consumed);
+        EXPECT_EQ(4, headers.size());
+        EXPECT_EQ("Duplicate", headers.at("Host"));
+        EXPECT_EQ("8", headers.at("Content-Length"));
+        EXPECT_EQ("my: body", std::string_view {sampleStr}.substr(consumed));
+
+        // Same pairs in the same order as the vector of views
+        auto views = siddiqsoft::string2map::parse_view<std::string_view>(sampleStr, ": ", "\r\n", "\r\n\r\n");
+        EXPECT_TRUE(std::equal(headers.begin(), headers.end(), views.begin(), views.end()));
+    }
+
+    TEST(flat_header_map, parse_converts_and_refills)
+    {
+        using namespace std;
+
+        auto wide = siddiqsoft::string2map::parse<string, wstring, flat_header_map<wchar_t>>("tag=networking&order=newest"s, "="s, "&"s);
+        ASSERT_EQ(2, wide.size());
+        EXPECT_EQ(L"newest", wide.at(L"order"));
+
+        auto narrow = siddiqsoft::string2map::parse<wstring, string, flat_header_map<char>>(L"a: 1\r\nb: 2\r\n\r\n"s, L": "s, L"\r\n"s, L"\r\n\r\n"s);
+        ASSERT_EQ(2, narrow.size());
+        EXPECT_EQ("2", narrow.at("b"));
+
+        flat_header_map<char> headers {};
+        EXPECT_EQ(3, siddiqsoft::string2map::parse_into(headers, "a=1&b=2&c=3"s, "="s, "&"s));
+        const auto* storage = headers.arena().data();
+        EXPECT_EQ(1, siddiqsoft::string2map::parse_into(headers, "z=26"s, "="s, "&"s));
+        EXPECT_EQ("26", headers.at("z"));
+        EXPECT_FALSE(headers.contains("a"));
+        EXPECT_EQ(storage, headers.arena().data());
+
+        siddiqsoft::string2map::stream_parser<string, string, flat_header_map<char>> parser {": "s, "\r\n"s, "\r\n\r\n"s};
+        parser.feed("Host: a\r");
+        parser.feed("\nAccept: b\r\n\r\nbody");
+        ASSERT_TRUE(parser.terminated());
+        EXPECT_EQ("b", parser.result().at("Accept"));
+    }
+
+    TEST(flat_header_map, case_insensitive_policy)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Content-Length: 8\r\nHOST: www.example.com\r\ncontent-length: 9\r\n\r\nmy: body"s;
+
+        auto headers = siddiqsoft::string2map::parse<string, string, flat_header_map<char, 32, case_insensitive>>(
+                sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        ASSERT_EQ(3, headers.size());
+        EXPECT_EQ("8", headers.at("content-length"));
+        EXPECT_EQ("8", headers.at("CONTENT-LENGTH"));
+        EXPECT_EQ(2, headers.count("Content-length"));
+        EXPECT_EQ("www.example.com", headers.at("host"));
+        EXPECT_FALSE(headers.contains("hosts"));
+        // Keys are stored as they appeared
+        EXPECT_EQ("HOST", (*headers.find("Host")).first);
+        EXPECT_EQ(flat_header_map<char>::hash("content-length"), headers.hash("Content-Length"));
+
+        auto wide = siddiqsoft::string2map::parse<string, wstring, flat_header_map<wchar_t, 8, case_insensitive>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(L"www.example.com", wide.at(L"Host"));
+
+        // The default policy is case-sensitive
+        auto exact = siddiqsoft::string2map::parse<string, string, flat_header_map<char>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_FALSE(exact.contains("host"));
+    }
+
+    TEST(flat_header_map, well_known_headers_perfect_hash)
+    {
+        using namespace std;
+
+        static_assert([] {
+            for (size_t i = 0; i < well_known_headers::count; ++i)
+            {
+                if (well_known_headers::lookup<case_sensitive>(well_known_headers::names[i]) != i) return false;
+            }
+            return true;
+        }());
+        static_assert(well_known_headers::lookup<case_insensitive>("content-LENGTH"sv) == static_cast<size_t>(header_id::content_length));
+        static_assert(well_known_headers::lookup<case_sensitive>("content-length"sv) == well_known_headers::count);
+        static_assert(well_known_headers::lookup<case_sensitive>(L"X-Forwarded-For"sv) == static_cast<size_t>(header_id::x_forwarded_for));
+
+        for (auto key : {""sv, "H"sv, "Hosts"sv, "Content-Lengths"sv, "X-Request-Id"sv, "Content_Length"sv})
+            EXPECT_EQ(well_known_headers::count, well_known_headers::lookup<case_insensitive>(key)) << key;
+        EXPECT_EQ(L"Transfer-Encoding"sv, well_known_headers::name<wchar_t>(static_cast<size_t>(header_id::transfer_encoding)));
+    }
+
+    TEST(flat_header_map, well_known_headers_interned)
+    {
+        using namespace std;
+        using interned_map = flat_header_map<char, 4, case_sensitive, well_known_headers>;
+
+        std::string sampleStr = "Host: www.example.com\r\nX-Request-Id: 42\r\nAccept: */*\r\nhost: lower\r\nAccept: text/html\r\n"
+                                "Content-Length: 8\r\n\r\nmy: body"s;
+
+        auto headers = siddiqsoft::string2map::parse<string, string, interned_map>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        ASSERT_EQ(6, headers.size());
+        EXPECT_EQ("www.example.com"sv, headers.get(header_id::host));
+        EXPECT_EQ("*/*"sv, headers.get(header_id::accept));
+        EXPECT_EQ("8"sv, headers.get(header_id::content_length));
+        EXPECT_EQ(std::nullopt, headers.get(header_id::cookie));
+        EXPECT_TRUE(headers.contains(header_id::accept));
+        EXPECT_EQ(headers.find("Accept"), headers.find(header_id::accept));
+
+        // Canonical names are not copied; unknown keys and other spellings are
+        EXPECT_EQ("www.example.com" "X-Request-Id" "42" "*/*" "host" "lower" "text/html" "8", headers.arena());
+        EXPECT_EQ(well_known_headers::names[static_cast<size_t>(header_id::host)].data(), (*headers.begin()).first.data());
+        EXPECT_EQ("lower", headers.at("host"));
+        EXPECT_EQ(2, headers.count("Accept"));
+        const auto plain = siddiqsoft::string2map::parse<string, string, flat_header_map<char>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ((vector<pair<string_view, string_view>>(plain.begin(), plain.end())),
+                  (vector<pair<string_view, string_view>>(headers.begin(), headers.end())));
+
+        const auto copy = headers;
+        EXPECT_EQ(headers, copy);
+        EXPECT_EQ("8"sv, copy.get(header_id::content_length));
+
+        headers.clear();
+        EXPECT_EQ(std::nullopt, headers.get(header_id::host));
+
+        // With case_insensitive any spelling is recognized; the key keeps the spelling of the source
+        auto wide = siddiqsoft::string2map::parse<string, wstring, flat_header_map<wchar_t, 32, case_insensitive, well_known_headers>>(
+                sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(L"www.example.com"sv, wide.get(header_id::host));
+        EXPECT_EQ(L"host"sv, (*std::next(wide.begin(), 3)).first);
+        EXPECT_EQ(2, wide.count(L"HOST"));
+    }
+
+#if defined(__cpp_lib_flat_map)
+    TEST(flat_header_map, std_flat_map_targets)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\n\r\nmy: body"s;
+
+        auto unique = siddiqsoft::string2map::parse<string, string, flat_map<string, string>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ((siddiqsoft::string2map::parse<string, string, map<string, string>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s)),
+                  (map<string, string>(unique.begin(), unique.end())));
+
+        auto multi = siddiqsoft::string2map::parse<string, wstring, flat_multimap<wstring, wstring>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(3, multi.size());
+        EXPECT_EQ(2, multi.count(L"Host"));
+
+        EXPECT_EQ(1, siddiqsoft::string2map::parse_into(unique, "x: y"s, ": "s, "\r\n"s));
+        EXPECT_EQ("y", unique.at("x"));
+    }
+#endif
+} // namespace siddiqsoft::string2map
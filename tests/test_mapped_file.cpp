@@ -0,0 +1,151 @@
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../include/siddiqsoft/mapped_file.hpp"
+
+
+namespace siddiqsoft
+{
+    namespace
+    {
+        /// @brief A file in the temporary directory removed at the end of the test.
+        struct temp_file
+        {
+            std::filesystem::path path;
+
+            temp_file(std::string_view name, std::string_view contents)
+                : path(std::filesystem::temp_directory_path() / name)
+            {
+                std::ofstream out {path, std::ios::binary | std::ios::trunc};
+                out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            }
+
+            ~temp_file()
+            {
+                std::error_code ignored {};
+                std::filesystem::remove(path, ignored);
+            }
+        };
+    } // namespace
+
+
+    TEST(mapped_file, maps_contents)
+    {
+        using namespace std;
+
+        const temp_file src {"string2map_mapped_file_contents.txt", "a=1\nb=2\n"sv};
+        mapped_file     file {src.path};
+        EXPECT_EQ("a=1\nb=2\n"sv, file.view());
+        EXPECT_EQ(8, file.size());
+
+        // Released pages are reloaded from the file when touched again.
+        file.release(file.size());
+        EXPECT_EQ("a=1\nb=2\n"sv, file.view());
+
+        mapped_file moved {std::move(file)};
+        EXPECT_TRUE(file.empty());
+        EXPECT_EQ("a=1\nb=2\n"sv, moved.view());
+
+        const temp_file empty {"string2map_mapped_file_empty.txt", ""sv};
+        EXPECT_TRUE(mapped_file {empty.path}.empty());
+
+        EXPECT_THROW(mapped_file {std::filesystem::temp_directory_path() / "string2map_mapped_file_missing.txt"}, std::system_error);
+    }
+
+    TEST(mapped_file, parse_file_matches_parse)
+    {
+        using namespace std;
+
+        const std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+        const temp_file   src {"string2map_mapped_file_headers.txt", sampleStr};
+
+        size_t expectedConsumed = 0;
+        auto   expected = siddiqsoft::string2map::parse<string, string, multimap<string, string>>(sampleStr, ": ", "\r\n", "\r\n\r\n", expectedConsumed);
+
+        size_t consumed = 0;
+        auto   parsed   = siddiqsoft::string2map::parse_file<string, multimap<string, string>>(src.path, ": ", "\r\n", "\r\n\r\n", consumed);
+        EXPECT_EQ(expected, parsed);
+        EXPECT_EQ(expectedConsumed, consumed);
+
+        auto wide = siddiqsoft::string2map::parse_file<wstring>(src.path, ": ", "\r\n", "\r\n\r\n");
+        EXPECT_EQ(3, wide.size());
+        EXPECT_EQ(L"8", wide.at(L"Content-Length"));
+
+        const temp_file empty {"string2map_mapped_file_empty_map.txt", ""sv};
+        EXPECT_TRUE(siddiqsoft::string2map::parse_file(empty.path, "=", "\n").empty());
+    }
+
+    TEST(mapped_file, parse_file_view_keeps_mapping_alive)
+    {
+        using namespace std;
+
+        const temp_file src {"string2map_mapped_file_view.txt", "PATH=/usr/bin\nHOME=/root\nEMPTY=\nPATH=/bin\n"sv};
+
+        siddiqsoft::mapped_result<std::vector<std::pair<string_view, string_view>>> result =
+                siddiqsoft::string2map::parse_file_view(src.path, "=", "\n");
+        auto moved = std::move(result);
+        ASSERT_EQ(4, moved->size());
+        EXPECT_EQ(make_pair("HOME"sv, "/root"sv), (*moved)[1]);
+        EXPECT_EQ(make_pair("PATH"sv, "/bin"sv), (*moved)[3]);
+        EXPECT_EQ(moved.file().data(), (*moved)[0].first.data());
+        EXPECT_EQ(moved.file().size(), moved.consumed());
+
+        auto lookup = siddiqsoft::string2map::parse_file_view<std::map<string_view, string_view>>(src.path, "=", "\n");
+        EXPECT_EQ("/usr/bin"sv, lookup->at("PATH"));
+    }
+
+    TEST(mapped_file, for_each_pair_in_file_streams)
+    {
+        using namespace std;
+
+        std::string records {};
+        for (int i = 0; i < 1000; ++i)
+            records += "key" + std::to_string(i) + "=" + std::to_string(i * i) + "&";
+        const temp_file src {"string2map_mapped_file_stream.txt", records};
+
+        size_t count = 0;
+        size_t total = 0;
+        auto   consumed = siddiqsoft::string2map::for_each_pair_in_file(src.path, "=", "&", "", [&](string_view, string_view value) {
+            ++count;
+            total += value.size();
+        });
+        EXPECT_EQ(1000, count);
+        EXPECT_EQ(records.size(), consumed);
+
+        std::vector<std::string> firstThree {};
+        consumed = siddiqsoft::string2map::for_each_pair_in_file(src.path, "=", "&", "", [&](string_view key, string_view) {
+            firstThree.emplace_back(key);
+            return firstThree.size() < 3;
+        });
+        EXPECT_EQ((std::vector<std::string> {"key0", "key1", "key2"}), firstThree);
+        EXPECT_EQ(records.find("key3"), consumed);
+    }
+
+    TEST(mapped_file, string2vector_parse_file)
+    {
+        using namespace std;
+
+        const std::string sampleStr = "/_vti_bin/ExcelRest.aspx/Docs/Documents/sampleWorkbook.xlsx/model/Charts('Chart%201')"s;
+        const temp_file   src {"string2map_mapped_file_tokens.txt", sampleStr};
+
+        EXPECT_EQ(siddiqsoft::string2vector::parse(sampleStr, "/"s), siddiqsoft::string2vector::parse_file(src.path, "/"));
+
+        auto view = siddiqsoft::string2vector::parse_file_view(src.path, "/");
+        ASSERT_EQ(7, view->size());
+        EXPECT_EQ("model"sv, (*view)[5]);
+
+        std::vector<std::string> tokens {};
+        EXPECT_EQ(2, siddiqsoft::string2vector::for_each_token_in_file(src.path, "/", [&](string_view token) {
+            tokens.emplace_back(token);
+            return tokens.size() < 2;
+        }));
+        EXPECT_EQ((std::vector<std::string> {"_vti_bin", "ExcelRest.aspx"}), tokens);
+    }
+} // namespace siddiqsoft
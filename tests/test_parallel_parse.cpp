@@ -0,0 +1,124 @@
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../include/siddiqsoft/parallel_parse.hpp"
+
+
+namespace siddiqsoft::parallel_parse
+{
+    namespace
+    {
+        /// @brief Pseudo-random text over a tiny alphabet so that delimiters, empty keys and delimiters inside keys are frequent.
+        template <typename T> T random_text(std::mt19937& rng, size_t length, const char* alphabet)
+        {
+            const std::string_view                letters {alphabet};
+            std::uniform_int_distribution<size_t> pick(0, letters.size() - 1);
+            T                                     text;
+            for (size_t i = 0; i < length; ++i)
+                text.push_back(static_cast<typename T::value_type>(letters[pick(rng)]));
+            return text;
+        }
+
+        /// @brief Well-formed "key=value&" records.
+        std::string random_records(std::mt19937& rng, size_t count)
+        {
+            std::string text;
+            for (size_t i = 0; i < count; ++i)
+                text += "k" + std::to_string(rng() % 500) + "=v" + std::to_string(rng()) + "&";
+            return text;
+        }
+
+        template <typename T, typename D, typename R>
+        void expect_parse_matches(const T& src, const T& keyDelimiter, const T& valueDelimiter, const T& terminalDelimiter)
+        {
+            size_t     serialConsumed = 0;
+            const auto serial = siddiqsoft::string2map::parse<T, D, R>(src, keyDelimiter, valueDelimiter, terminalDelimiter, serialConsumed);
+
+            for (unsigned threads : {2u, 3u, 8u})
+            {
+                for (size_t minChunk : {1u, 7u, 64u})
+                {
+                    size_t     consumed = 0;
+                    const auto parallel = siddiqsoft::string2map::parse_parallel<T, D, R>(
+                            src, keyDelimiter, valueDelimiter, terminalDelimiter, consumed, options {threads, minChunk});
+                    ASSERT_EQ(serial, parallel) << "threads " << threads << " chunk " << minChunk;
+                    ASSERT_EQ(serialConsumed, consumed) << "threads " << threads << " chunk " << minChunk;
+                }
+            }
+        }
+    } // namespace
+
+
+    TEST(parallel_parse, string2vector_matches_parse)
+    {
+        using namespace std;
+
+        std::mt19937 rng {20240801};
+        for (size_t length : {0u, 1u, 10u, 100u, 1000u, 5000u})
+        {
+            const auto src  = random_text<std::string>(rng, length, "abc ,;\t");
+            const auto wsrc = random_text<std::wstring>(rng, length, "abc ,;\t");
+            for (unsigned threads : {1u, 2u, 5u, 16u})
+            {
+                for (size_t minChunk : {1u, 16u, 4096u})
+                {
+                    EXPECT_EQ(siddiqsoft::string2vector::parse(src, " ,;\t"s),
+                              siddiqsoft::string2vector::parse_parallel(src, " ,;\t"s, options {threads, minChunk}));
+                    EXPECT_EQ(siddiqsoft::string2vector::parse(wsrc, L",;"s),
+                              siddiqsoft::string2vector::parse_parallel(wsrc, L",;"s, options {threads, minChunk}));
+                }
+            }
+        }
+    }
+
+    TEST(parallel_parse, string2map_matches_parse_random)
+    {
+        using namespace std;
+
+        std::mt19937 rng {20240802};
+        for (size_t length : {0u, 5u, 50u, 300u, 2000u})
+        {
+            for (int round = 0; round < 4; ++round)
+            {
+                // Malformed input, value delimiters inside keys and terminals which begin inside a value delimiter
+                const auto src = random_text<std::string>(rng, length, "ab=&&");
+                expect_parse_matches<string, string, map<string, string>>(src, "="s, "&"s, "&&&"s);
+                expect_parse_matches<string, string, multimap<string, string>>(src, "="s, "&"s, ""s);
+                expect_parse_matches<string, string, map<string, string>>(src, "=&"s, "&"s, "a&&"s);
+
+                const auto headers = random_text<std::string>(rng, length, "ab: \r\n\r\n");
+                expect_parse_matches<string, string, multimap<string, string>>(headers, ": "s, "\r\n"s, "\r\n\r\n"s);
+                expect_parse_matches<string, wstring, map<wstring, wstring>>(headers, ":"s, "\r\n"s, "\r\n\r\n"s);
+            }
+        }
+    }
+
+    TEST(parallel_parse, string2map_matches_parse_records)
+    {
+        using namespace std;
+
+        std::mt19937 rng {20240803};
+        const auto   src = random_records(rng, 3000);
+
+        expect_parse_matches<string, string, map<string, string>>(src, "="s, "&"s, ""s);
+        expect_parse_matches<string, string, multimap<string, string>>(src, "="s, "&"s, ""s);
+        expect_parse_matches<string, string, unordered_map<string, string>>(src, "="s, "&"s, ""s);
+        expect_parse_matches<string, string, siddiqsoft::string2map::flat_header_map<char>>(src, "="s, "&"s, ""s);
+
+        // The terminal delimiter in the middle of the input
+        const auto framed = src.substr(0, src.size() / 2) + "&" + src.substr(src.size() / 2);
+        expect_parse_matches<string, string, multimap<string, string>>(framed, "="s, "&"s, "&&"s);
+        // An early terminal delimiter: the chunks beyond it stop without contributing
+        const auto early = src.substr(0, src.size() / 50) + "&" + src.substr(src.size() / 50);
+        expect_parse_matches<string, string, map<string, string>>(early, "="s, "&"s, "&&"s);
+
+        const std::wstring wide(src.begin(), src.end());
+        expect_parse_matches<wstring, string, map<string, string>>(wide, L"="s, L"&"s, L""s);
+    }
+} // namespace siddiqsoft::parallel_parse
@@ -0,0 +1,230 @@
+#include <map>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "../include/siddiqsoft/parse_batch.hpp"
+
+
+namespace siddiqsoft::string2map
+{
+    namespace
+    {
+        /// @brief The records of the batch result as multimaps (so duplicates and order within a key are compared).
+        template <typename C> std::vector<std::multimap<std::basic_string<C>, std::basic_string<C>>> to_maps(const batch_result<C>& batch)
+        {
+            std::vector<std::multimap<std::basic_string<C>, std::basic_string<C>>> maps {};
+            for (const auto& record : batch)
+            {
+                auto& m = maps.emplace_back();
+                for (auto [key, value] : record)
+                    m.emplace(key, value);
+            }
+            return maps;
+        }
+
+        /// @brief Log lines "key=value&..." with a random number of pairs, an occasional empty line and malformed pair.
+        std::vector<std::string> random_lines(std::mt19937& rng, size_t count)
+        {
+            std::vector<std::string> lines {};
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto& line = lines.emplace_back();
+                for (auto pairs = rng() % 6; pairs > 0; --pairs)
+                    line += "k" + std::to_string(rng() % 20) + "=v" + std::to_string(rng() % 1000) + "&";
+                if (rng() % 7 == 0) line += "=oops&k=after";
+                if (rng() % 5 == 0) line += "k0=trailing";
+            }
+            return lines;
+        }
+    } // namespace
+
+
+    TEST(parse_batch, matches_parse_per_record)
+    {
+        using namespace std;
+
+        const std::vector<std::string> records {"Host: a\r\nAccept: b\r\n\r\nbody: ignored"s,
+                                                ""s,
+                                                "Host: Duplicate\r\nHost: Hi\r\n"s,
+                                                "no delimiters at all"s,
+                                                ": empty key\r\nHost: x\r\n"s};
+
+        const auto batch = parse_batch<std::string>(records, ": "s, "\r\n"s, "\r\n\r\n"s);
+        ASSERT_EQ(records.size(), batch.size());
+
+        size_t pairs = 0;
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            size_t     consumed = 0;
+            const auto expected = parse<string, string, multimap<string, string>>(records[i], ": "s, "\r\n"s, "\r\n\r\n"s, consumed);
+            EXPECT_EQ(expected, to_maps(batch)[i]) << "record " << i;
+            EXPECT_EQ(consumed, batch[i].consumed()) << "record " << i;
+            pairs += expected.size();
+        }
+        EXPECT_EQ(pairs, batch.pairs());
+
+        // Duplicates keep source order; find returns the first.
+        ASSERT_EQ(2, batch[2].size());
+        EXPECT_EQ(make_pair("Host"sv, "Duplicate"sv), batch[2][0]);
+        EXPECT_EQ(make_pair("Host"sv, "Hi"sv), batch[2][1]);
+        EXPECT_EQ("Duplicate"sv, batch[2].at("Host"));
+        EXPECT_TRUE(batch[0].contains("Accept"));
+        EXPECT_FALSE(batch[0].contains("body"));
+        EXPECT_TRUE(batch[1].empty());
+        EXPECT_THROW(batch[1].at("Host"), std::out_of_range);
+        EXPECT_THROW(batch.at(records.size()), std::out_of_range);
+
+        // Every key and value lives in the shared arena.
+        const std::string_view arena {batch.arena()};
+        for (const auto& record : batch)
+        {
+            for (auto [key, value] : record)
+            {
+                EXPECT_GE(key.data(), arena.data());
+                EXPECT_LE(value.data() + value.size(), arena.data() + arena.size());
+            }
+        }
+    }
+
+    TEST(parse_batch, views_and_wide)
+    {
+        using namespace std;
+
+        const std::string              text {"a=1&b=2\nc=3\n\nd=4&d=5"};
+        std::vector<std::string_view>  lines {};
+        for (auto line : siddiqsoft::string2vector::split_view<char> {text, "\n"sv})
+            lines.push_back(line);
+        // split_view skips the empty line
+        ASSERT_EQ(3, lines.size());
+
+        const auto batch = parse_batch<std::string_view>(lines, "="sv, "&"sv);
+        ASSERT_EQ(3, batch.size());
+        EXPECT_EQ("2"sv, batch[0].at("b"));
+        EXPECT_EQ("3"sv, batch[1].at("c"));
+        EXPECT_EQ(2, batch[2].size());
+        EXPECT_EQ(5, batch.pairs());
+
+        const std::vector<std::wstring> wide {L"x=1&y=2"s, L"z=3"s};
+        const auto                      wbatch = parse_batch<std::wstring>(std::span<const std::wstring> {wide}, L"="s, L"&"s);
+        ASSERT_EQ(2, wbatch.size());
+        EXPECT_EQ(L"2"sv, wbatch[0].at(L"y"));
+        EXPECT_EQ(L"3"sv, wbatch[1].at(L"z"));
+
+        EXPECT_TRUE(parse_batch<std::string_view>({}, "="sv, "&"sv).empty());
+
+        // Empty delimiters yield empty records (as parse yields an empty map).
+        const auto none = parse_batch<std::string_view>(lines, ""sv, "&"sv);
+        ASSERT_EQ(3, none.size());
+        EXPECT_EQ(0, none.pairs());
+    }
+
+    TEST(parse_batch, parallel_matches_serial)
+    {
+        using namespace std;
+
+        std::mt19937 rng {20240901};
+        for (size_t count : {0u, 1u, 3u, 50u, 2000u})
+        {
+            const auto lines  = random_lines(rng, count);
+            const auto serial = parse_batch<std::string>(lines, "="s, "&"s, "&&"s);
+
+            for (unsigned threads : {1u, 2u, 3u, 8u})
+            {
+                for (size_t minChunk : {1u, 10u, 1000u})
+                {
+                    const auto parallel = parse_batch<std::string>(lines, "="s, "&"s, "&&"s, parallel_parse::options {threads, minChunk});
+                    ASSERT_EQ(serial.size(), parallel.size());
+                    ASSERT_EQ(serial.arena(), parallel.arena()) << "threads " << threads << " chunk " << minChunk;
+                    ASSERT_EQ(to_maps(serial), to_maps(parallel));
+                    for (size_t i = 0; i < serial.size(); ++i)
+                        ASSERT_EQ(serial[i].consumed(), parallel[i].consumed());
+                }
+            }
+        }
+    }
+
+    TEST(parse_batch, columns_pivot_records)
+    {
+        using namespace std;
+
+        const std::string_view log {"status=200&latency=12&path=/a\n"
+                                    "status=404&path=/b\n"
+                                    "\n"
+                                    "latency=7&status=500&status=999&user=\n"
+                                    "path=/c&&ignored=1\n"};
+
+        const auto table = parse_columns(log, "\n"sv, "="sv, "&"sv, "&&"sv);
+        ASSERT_EQ(4, table.rows());
+        ASSERT_EQ(4, table.columns());
+        EXPECT_EQ((std::vector<std::string_view> {"status", "latency", "path", "user"}),
+                  (std::vector<std::string_view> {table.keys().begin(), table.keys().end()}));
+
+        // Null where the record lacks the key; a repeated key keeps its first value.
+        const auto status = table.at("status");
+        EXPECT_EQ((std::vector<std::optional<std::string_view>> {"200"sv, "404"sv, "500"sv, std::nullopt}),
+                  (std::vector<std::optional<std::string_view>> {status.begin(), status.end()}));
+        const auto latency = table.at("latency");
+        EXPECT_EQ("12"sv, latency[0]);
+        EXPECT_TRUE(latency.is_null(1));
+        EXPECT_EQ("7"sv, latency[2]);
+        // An empty value is not null.
+        const auto user = table[*table.key_id("user")];
+        EXPECT_TRUE(user.is_null(0));
+        EXPECT_EQ(""sv, user[2]);
+        EXPECT_EQ("/c"sv, table.at("path")[3]);
+        EXPECT_FALSE(table.contains("ignored"));
+        EXPECT_FALSE(table.key_id("ignored").has_value());
+        EXPECT_THROW(table.at("ignored"), std::out_of_range);
+
+        // The cells are offsets into the row's record.
+        const auto cell = status.cells()[1];
+        EXPECT_EQ(7, cell.offset);
+        EXPECT_EQ("404"sv, log.substr(status.offset(1), cell.length));
+        EXPECT_TRUE(status.cells()[3].is_null());
+
+        const auto wide = parse_columns(L"a=1\r\nb=2"sv, L"\r\n"sv, L"="sv, L"&"sv);
+        ASSERT_EQ(2, wide.rows());
+        EXPECT_EQ(L"2"sv, wide.at(L"b")[1]);
+        EXPECT_FALSE(wide.at(L"b")[0].has_value());
+
+        EXPECT_EQ(0, parse_columns(""sv, "\n"sv, "="sv, "&"sv).rows());
+        EXPECT_EQ(1, parse_columns("a=1\nb=2"sv, ""sv, "="sv, "&"sv).rows());
+    }
+
+    TEST(parse_batch, columns_match_parse_per_record)
+    {
+        using namespace std;
+
+        std::mt19937 rng {20240902};
+        const auto   lines = random_lines(rng, 500);
+        std::string  text {};
+        for (const auto& line : lines)
+            text += line + "\n";
+
+        const auto table = parse_columns(std::string_view {text}, "\n"sv, "="sv, "&"sv);
+
+        size_t row = 0;
+        for (const auto& line : lines)
+        {
+            if (line.empty()) continue;
+            const auto expected = parse<string, string, map<string, string>>(line, "="s, "&"s);
+            size_t     present  = 0;
+            for (size_t id = 0; id < table.columns(); ++id)
+            {
+                const auto value = table[id][row];
+                if (!value) continue;
+                ++present;
+                EXPECT_EQ(expected.at(std::string {table.keys()[id]}), *value) << "row " << row;
+            }
+            EXPECT_EQ(expected.size(), present) << "row " << row;
+            ++row;
+        }
+        EXPECT_EQ(row, table.rows());
+    }
+} // namespace siddiqsoft::string2map
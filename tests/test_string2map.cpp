@@ -1,5 +1,10 @@
+#include <random>
 #include <string>
+#include <tuple>
+#include <string_view>
+#include <array>
 #include <map>
+#include <memory_resource>
 #include <unordered_map>
 
 #include "gtest/gtest.h"
@@ -311,4 +316,1094 @@ namespace siddiqsoft::string2map
         EXPECT_EQ("1", kvmap["a"]);
     }
 
+
+    // ---- parse_view (zero-copy) tests ----
+
+    TEST(string2map, view_string_vector)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        // The default container is a vector of views which preserves source order and duplicates.
+        auto kv = siddiqsoft::string2map::parse_view<string_view>(sampleStr, ": ", "\r\n", "\r\n\r\n");
+        ASSERT_EQ(4, kv.size());
+        EXPECT_EQ("Host", kv[0].first);
+        EXPECT_EQ("Duplicate", kv[0].second);
+        EXPECT_EQ("Hi", kv[1].second);
+        EXPECT_EQ("Content-Length", kv[3].first);
+        EXPECT_EQ("8", kv[3].second);
+        // The views must refer to the source buffer; no copies.
+        EXPECT_EQ(sampleStr.data(), kv[0].first.data());
+        EXPECT_EQ(sampleStr.data() + 6, kv[0].second.data());
+    }
+
+    TEST(string2map, view_string_map)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        auto kvmap = siddiqsoft::string2map::parse_view<string_view, map<string_view, string_view>>(
+                sampleStr, ": ", "\r\n", "\r\n\r\n");
+        EXPECT_EQ(3, kvmap.size());
+        // First one wins in the map; same as parse.
+        EXPECT_EQ("Duplicate", kvmap["Host"]);
+    }
+
+    TEST(string2map, view_string_unorderedmap)
+    {
+        using namespace std;
+
+        std::string sampleStr = "tag=networking&order=newest&final=section"s;
+
+        auto kvmap = siddiqsoft::string2map::parse_view<string_view, unordered_map<string_view, string_view>>(sampleStr, "=", "&");
+        EXPECT_EQ(3, kvmap.size());
+        EXPECT_EQ("section", kvmap["final"]);
+    }
+
+    TEST(string2map, view_wstring_multimap)
+    {
+        using namespace std;
+
+        std::wstring sampleStr = L"Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        auto kvmap = siddiqsoft::string2map::parse_view<wstring_view, multimap<wstring_view, wstring_view>>(
+                sampleStr, L": ", L"\r\n", L"\r\n\r\n");
+        EXPECT_EQ(4, kvmap.size());
+        EXPECT_EQ(2, kvmap.count(L"Host"));
+    }
+
+    TEST(string2map, view_wstring_vector_no_terminal)
+    {
+        using namespace std;
+
+        std::wstring sampleStr = L"Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        // Without the terminal delimiter the final key is `\r\nmy`; same as parse.
+        auto kv = siddiqsoft::string2map::parse_view<wstring_view>(sampleStr, L": ", L"\r\n");
+        ASSERT_EQ(5, kv.size());
+        EXPECT_EQ(L"\r\nmy", kv[4].first);
+        EXPECT_EQ(L"body", kv[4].second);
+    }
+
+    TEST(string2map, view_edge_cases)
+    {
+        using namespace std;
+
+        EXPECT_TRUE(siddiqsoft::string2map::parse_view<string_view>("", "=", "&").empty());
+        EXPECT_TRUE(siddiqsoft::string2map::parse_view<string_view>("key=value&foo=bar", "", "&").empty());
+        EXPECT_TRUE(siddiqsoft::string2map::parse_view<string_view>("key=value&foo=bar", "=", "").empty());
+        EXPECT_TRUE(siddiqsoft::string2map::parse_view<string_view>("nokeydelimiterhere", "=", "&").empty());
+        EXPECT_TRUE(siddiqsoft::string2map::parse_view<string_view>("=&=&", "=", "&").empty());
+        EXPECT_TRUE(siddiqsoft::string2map::parse_view<string_view>("\r\n\r\nkey=value", "=", "&", "\r\n\r\n").empty());
+
+        auto kv = siddiqsoft::string2map::parse_view<string_view>("key=&foo=bar&", "=", "&");
+        ASSERT_EQ(2, kv.size());
+        EXPECT_EQ("", kv[0].second);
+        EXPECT_EQ("bar", kv[1].second);
+
+        kv = siddiqsoft::string2map::parse_view<string_view>("a: 1\r\nb: 2\r\n\r\nBODY", ": ", "\r\n", "\r\n\r\n");
+        ASSERT_EQ(2, kv.size());
+        EXPECT_EQ("2", kv[1].second);
+    }
+
+    TEST(string2map, view_matches_parse)
+    {
+        using namespace std;
+
+        // The zero-copy and the owning variants share the scanner and must agree on every element.
+        for (const auto& [src, term] : std::vector<std::pair<std::string, std::string>> {
+                     {"Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body", "\r\n\r\n"},
+                     {"Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body", ""},
+                     {"a: 1\r\n\r\nb: 2\r\n\r\nc: 3", "\r\n\r\n"},
+                     {"key=value&foo=bar", "|||"}})
+        {
+            auto owned = siddiqsoft::string2map::parse<string, string, multimap<string, string>>(src, ": "s, "\r\n"s, term);
+            auto views = siddiqsoft::string2map::parse_view<string_view, multimap<string_view, string_view>>(src, ": ", "\r\n", term);
+            ASSERT_EQ(owned.size(), views.size());
+            EXPECT_TRUE(std::equal(owned.begin(), owned.end(), views.begin(), [](const auto& a, const auto& b) {
+                return a.first == b.first && a.second == b.second;
+            }));
+        }
+    }
+
+
+    TEST(string2map, simd_matches_scalar)
+    {
+        using namespace std;
+
+        std::string  src;
+        std::wstring wsrc;
+        for (int i = 0; i < 64; ++i)
+        {
+            src += "X-Header-" + std::to_string(i) + ": value " + std::to_string(i * 7) + "\r\n";
+            wsrc += L"X-Header-" + std::to_wstring(i) + L": value " + std::to_wstring(i * 7) + L"\r\n";
+        }
+        src += "\r\nX-Not-A-Header: body";
+        wsrc += L"\r\nX-Not-A-Header: body";
+
+        const auto saved = siddiqsoft::delimiter_scan::active_level();
+
+        siddiqsoft::delimiter_scan::set_active_level(siddiqsoft::delimiter_scan::simd_level::scalar);
+        auto expected  = siddiqsoft::string2map::parse<string, string, multimap<string, string>>(src, ": "s, "\r\n"s, "\r\n\r\n"s);
+        auto wexpected = siddiqsoft::string2map::parse<wstring, wstring, multimap<wstring, wstring>>(wsrc, L": "s, L"\r\n"s, L"\r\n\r\n"s);
+        EXPECT_EQ(64, expected.size());
+        EXPECT_EQ(64, wexpected.size());
+
+        for (auto level : {siddiqsoft::delimiter_scan::simd_level::sse2, siddiqsoft::delimiter_scan::simd_level::avx2})
+        {
+            siddiqsoft::delimiter_scan::set_active_level(level);
+            EXPECT_EQ(expected, (siddiqsoft::string2map::parse<string, string, multimap<string, string>>(src, ": "s, "\r\n"s, "\r\n\r\n"s)));
+            EXPECT_EQ(wexpected,
+                      (siddiqsoft::string2map::parse<wstring, wstring, multimap<wstring, wstring>>(wsrc, L": "s, L"\r\n"s, L"\r\n\r\n"s)));
+        }
+
+        siddiqsoft::delimiter_scan::set_active_level(saved);
+    }
+
+
+    // ---- Single pass / consumed tests ----
+
+    TEST(string2map, consumed_stops_after_terminal)
+    {
+        using namespace std;
+
+        std::string src = "Host: Hi\r\nContent-Length: 12\r\n\r\nbody: a\r\nb: c"s;
+        size_t      consumed {};
+        auto        kvmap = siddiqsoft::string2map::parse<string>(src, ": "s, "\r\n"s, "\r\n\r\n"s, consumed);
+        EXPECT_EQ(2, kvmap.size());
+        // The remainder of the buffer is the body.
+        EXPECT_EQ("body: a\r\nb: c", src.substr(consumed));
+    }
+
+    TEST(string2map, consumed_without_terminal)
+    {
+        using namespace std;
+
+        size_t consumed {};
+        // Every element parsed; the entire source is consumed.
+        siddiqsoft::string2map::parse<string>("key=value&foo=bar"s, "="s, "&"s, ""s, consumed);
+        EXPECT_EQ(17, consumed);
+        // Trailing value delimiter is consumed.
+        siddiqsoft::string2map::parse<string>("key=value&"s, "="s, "&"s, ""s, consumed);
+        EXPECT_EQ(10, consumed);
+        // Stops at the start of the fragment without a key delimiter.
+        siddiqsoft::string2map::parse<string>("key=value&partial"s, "="s, "&"s, ""s, consumed);
+        EXPECT_EQ(10, consumed);
+        // Terminal delimiter not found.
+        siddiqsoft::string2map::parse<string>("key=value&foo=bar"s, "="s, "&"s, "|||"s, consumed);
+        EXPECT_EQ(17, consumed);
+        // Nothing to do.
+        siddiqsoft::string2map::parse<string>(""s, "="s, "&"s, ""s, consumed);
+        EXPECT_EQ(0, consumed);
+    }
+
+    TEST(string2map, consumed_terminal_at_start)
+    {
+        using namespace std;
+
+        size_t consumed {};
+        auto   kv = siddiqsoft::string2map::parse_view<string_view>("\r\n\r\nkey=value", "=", "&", "\r\n\r\n", consumed);
+        EXPECT_TRUE(kv.empty());
+        EXPECT_EQ(4, consumed);
+    }
+
+    TEST(string2map, consumed_wstring)
+    {
+        using namespace std;
+
+        std::wstring src = L"a: 1\r\nb: 2\r\n\r\nBODY"s;
+        size_t       consumed {};
+        auto         kvmap = siddiqsoft::string2map::parse<wstring, string>(src, L": "s, L"\r\n"s, L"\r\n\r\n"s, consumed);
+        EXPECT_EQ(2, kvmap.size());
+        EXPECT_EQ(L"BODY", src.substr(consumed));
+    }
+
+    namespace
+    {
+        /// @brief The original two-pass algorithm (pre-scan for the terminal then clamp) kept as the reference.
+        std::vector<std::pair<std::string, std::string>>
+        reference_parse(const std::string& src, const std::string& kd, const std::string& vd, const std::string& td)
+        {
+            std::vector<std::pair<std::string, std::string>> result;
+            if (src.empty() || kd.empty() || vd.empty()) return result;
+
+            size_t posT = !td.empty() ? src.find(td) : std::string::npos;
+            for (size_t keyStart = 0; keyStart < src.length() && keyStart < posT;)
+            {
+                auto keyEnd = src.find(kd, keyStart);
+                if (keyEnd == std::string::npos || keyEnd >= posT) break;
+                auto key      = src.substr(keyStart, keyEnd - keyStart);
+                auto valueEnd = src.find(vd, keyEnd + kd.length());
+                if (valueEnd != std::string::npos && posT != std::string::npos && valueEnd >= posT) valueEnd = std::string::npos;
+                if (key.empty()) break;
+                auto vs = keyEnd + kd.length();
+                result.emplace_back(key,
+                                    src.substr(vs,
+                                               valueEnd != std::string::npos ? valueEnd - vs
+                                                                             : (posT != std::string::npos ? posT - vs : std::string::npos)));
+                if (valueEnd == std::string::npos) break;
+                keyStart = valueEnd + vd.length();
+            }
+            return result;
+        }
+    } // namespace
+
+    TEST(string2map, single_pass_matches_reference)
+    {
+        using namespace std;
+
+        std::mt19937                          rng {424242};
+        static constexpr char                 alphabet[] = "ab: \r\n=&";
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+
+        for (int round = 0; round < 2000; ++round)
+        {
+            std::string src;
+            for (size_t i = 0, len = round % 64; i < len; ++i)
+                src.push_back(alphabet[pick(rng)]);
+
+            for (const auto& [kd, vd, td] : std::vector<std::tuple<std::string, std::string, std::string>> {
+                         {": ", "\r\n", "\r\n\r\n"}, {": ", "\r\n", ""}, {"=", "&", ""}, {"=", "&", "\r\n"}, {":", "\r\n", "\r\n\r\n"}})
+            {
+                auto expected = reference_parse(src, kd, vd, td);
+                auto actual   = siddiqsoft::string2map::parse_view<string_view>(src, kd, vd, td);
+                ASSERT_EQ(expected.size(), actual.size()) << "round " << round;
+                for (size_t i = 0; i < expected.size(); ++i)
+                {
+                    ASSERT_EQ(expected[i].first, actual[i].first) << "round " << round;
+                    ASSERT_EQ(expected[i].second, actual[i].second) << "round " << round;
+                }
+            }
+        }
+    }
+
+
+    TEST(string2map, fixed_delimiters_match_runtime)
+    {
+        using namespace std;
+
+        std::mt19937                          rng {20240612};
+        static constexpr char                 alphabet[] = "ab: \r\n=&";
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+
+        for (int round = 0; round < 2000; ++round)
+        {
+            std::string src;
+            for (size_t i = 0, len = round % 64; i < len; ++i)
+                src.push_back(alphabet[pick(rng)]);
+
+            size_t expectedConsumed {};
+            size_t consumed {};
+            using multi = multimap<string, string>;
+
+            auto headers = siddiqsoft::string2map::parse<": ", "\r\n", "\r\n\r\n", string, string, multi>(src, consumed);
+            ASSERT_EQ((siddiqsoft::string2map::parse<string, string, multi>(src, ": "s, "\r\n"s, "\r\n\r\n"s, expectedConsumed)), headers);
+            ASSERT_EQ(expectedConsumed, consumed) << "round " << round;
+
+            auto query = siddiqsoft::string2map::parse<"=", "&", "", string, string, multi>(src, consumed);
+            ASSERT_EQ((siddiqsoft::string2map::parse<string, string, multi>(src, "="s, "&"s, ""s, expectedConsumed)), query);
+            ASSERT_EQ(expectedConsumed, consumed) << "round " << round;
+
+            auto mixed = siddiqsoft::string2map::parse<":", "\r\n", "\r\n\r\n", string, string, multi>(src, consumed);
+            ASSERT_EQ((siddiqsoft::string2map::parse<string, string, multi>(src, ":"s, "\r\n"s, "\r\n\r\n"s, expectedConsumed)), mixed);
+            ASSERT_EQ(expectedConsumed, consumed) << "round " << round;
+        }
+    }
+
+    TEST(string2map, fixed_delimiters_types)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        auto kvmap = siddiqsoft::string2map::parse<": ", "\r\n", "\r\n\r\n">(sampleStr);
+        EXPECT_EQ(3, kvmap.size());
+
+        // Narrow literals are widened for a wide source; conversion to string as with parse
+        auto wkvmap = siddiqsoft::string2map::parse<": ", "\r\n", "\r\n\r\n", wstring, string, unordered_map<string, string>>(
+                L"Host: Hi\r\nAccept: Something\r\n\r\nmy: body"s);
+        EXPECT_EQ(2, wkvmap.size());
+        EXPECT_EQ("Something", wkvmap.at("Accept"));
+
+        auto query = siddiqsoft::string2map::parse<"=", "&">(L"tag=networking&order=newest&final=section"s);
+        EXPECT_EQ(3, query.size());
+        EXPECT_EQ(L"newest", query.at(L"order"));
+    }
+
+    // ---- stream_parser tests ----
+
+    TEST(string2map, stream_every_split_point)
+    {
+        using namespace std;
+
+        const std::string src = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+        const auto        expected = siddiqsoft::string2map::parse<string, string, multimap<string, string>>(src, ": "s, "\r\n"s, "\r\n\r\n"s);
+
+        // Split the input in two at every possible position (delimiters included).
+        for (size_t split = 0; split <= src.size(); ++split)
+        {
+            siddiqsoft::string2map::stream_parser<string, string, multimap<string, string>> parser {": "s, "\r\n"s, "\r\n\r\n"s};
+
+            size_t used = parser.feed(std::string_view {src}.substr(0, split));
+            if (!parser.done()) used = split + parser.feed(std::string_view {src}.substr(split));
+
+            EXPECT_TRUE(parser.terminated()) << "split " << split;
+            EXPECT_EQ(src.find("my: body"), used) << "split " << split;
+            EXPECT_EQ(expected, parser.result()) << "split " << split;
+        }
+    }
+
+    TEST(string2map, stream_byte_by_byte)
+    {
+        using namespace std;
+
+        const std::string src = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        siddiqsoft::string2map::stream_parser<string, string, multimap<string, string>> parser {": "s, "\r\n"s, "\r\n\r\n"s};
+
+        size_t offset = 0;
+        for (; offset < src.size() && !parser.done(); ++offset)
+        {
+            EXPECT_EQ(1, parser.feed(std::string_view {src}.substr(offset, 1)));
+            // A pair is available as soon as its value delimiter is known not to be the start of the terminal delimiter.
+            if (offset == src.find("Host: Hi"))
+            {
+                EXPECT_EQ(1, parser.result().size());
+            }
+        }
+
+        EXPECT_TRUE(parser.terminated());
+        EXPECT_EQ(4, parser.result().size());
+        // The body follows the terminal delimiter.
+        EXPECT_EQ("my: body", src.substr(offset));
+    }
+
+    TEST(string2map, stream_reports_body_offset_in_last_chunk)
+    {
+        using namespace std;
+
+        siddiqsoft::string2map::stream_parser<string> parser {": "s, "\r\n"s, "\r\n\r\n"s};
+
+        EXPECT_EQ(10, parser.feed("Host: Hi\r\n"));
+        EXPECT_EQ(4, parser.feed("a: b"));
+        EXPECT_FALSE(parser.done());
+
+        std::string_view last = "\r\n\r\nBODY";
+        auto             used = parser.feed(last);
+        EXPECT_TRUE(parser.terminated());
+        EXPECT_EQ("BODY", last.substr(used));
+        EXPECT_EQ("b", parser.result().at("a"));
+
+        // Further input is ignored once the terminal delimiter has been reached.
+        EXPECT_EQ(0, parser.feed("x: y\r\n"));
+        EXPECT_EQ(2, parser.result().size());
+    }
+
+    TEST(string2map, stream_finish_without_terminal)
+    {
+        using namespace std;
+
+        siddiqsoft::string2map::stream_parser<string> parser {"="s, "&"s};
+
+        parser.feed("tag=netw");
+        parser.feed("orking&ord");
+        parser.feed("er=newest&final=sec");
+        EXPECT_EQ(2, parser.result().size());
+        EXPECT_FALSE(parser.done());
+
+        parser.finish();
+        EXPECT_TRUE(parser.done());
+        EXPECT_FALSE(parser.terminated());
+        EXPECT_EQ(3, parser.result().size());
+        EXPECT_EQ("sec", parser.result().at("final"));
+
+        // Reuse for the next input.
+        parser.reset();
+        parser.feed("a=1&");
+        EXPECT_EQ(1, parser.result().size());
+    }
+
+    TEST(string2map, stream_wstring_to_string_three_way_splits)
+    {
+        using namespace std;
+
+        const std::wstring src      = L"a: 1\r\nbb: 22\r\nccc: 333\r\n\r\nd: 4"s;
+        const auto         expected = siddiqsoft::string2map::parse<wstring, string>(src, L": "s, L"\r\n"s, L"\r\n\r\n"s);
+
+        for (size_t i = 0; i <= src.size(); ++i)
+        {
+            for (size_t j = i; j <= src.size(); ++j)
+            {
+                siddiqsoft::string2map::stream_parser<wstring, string> parser {L": "s, L"\r\n"s, L"\r\n\r\n"s};
+                parser.feed(std::wstring_view {src}.substr(0, i));
+                parser.feed(std::wstring_view {src}.substr(i, j - i));
+                parser.feed(std::wstring_view {src}.substr(j));
+                parser.finish();
+                ASSERT_EQ(expected, parser.result()) << i << "," << j;
+            }
+        }
+    }
+
+    TEST(string2map, stream_matches_parse_random)
+    {
+        using namespace std;
+
+        std::mt19937                          rng {777};
+        static constexpr char                 alphabet[] = "ab: \r\n";
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+
+        for (int round = 0; round < 500; ++round)
+        {
+            std::string src;
+            for (size_t i = 0, len = round % 48; i < len; ++i)
+                src.push_back(alphabet[pick(rng)]);
+
+            size_t     consumed {};
+            const auto expected =
+                    siddiqsoft::string2map::parse<string, string, multimap<string, string>>(src, ": "s, "\r\n"s, "\r\n\r\n"s, consumed);
+
+            siddiqsoft::string2map::stream_parser<string, string, multimap<string, string>> parser {": "s, "\r\n"s, "\r\n\r\n"s};
+            std::uniform_int_distribution<size_t> chunk(1, 5);
+            size_t                                offset = 0;
+            while (offset < src.size() && !parser.done())
+            {
+                auto piece = std::string_view {src}.substr(offset, chunk(rng));
+                auto used  = parser.feed(piece);
+                offset += used;
+                if (used < piece.size()) break;
+            }
+            parser.finish();
+
+            ASSERT_EQ(expected, parser.result()) << "round " << round << " src " << src;
+            if (parser.terminated())
+            {
+                ASSERT_EQ(consumed, offset) << "round " << round;
+            }
+        }
+    }
+
+    TEST(string2map, pmr_map_from_single_resource)
+    {
+        using namespace std;
+
+        std::string sampleStr = "X-Request-Identifier: 0123456789abcdef0123456789\r\nAccept-Language: en-US,en;q=0.9,fr;q=0.8\r\n"
+                                "\r\nbody"s;
+
+        // Every allocation (nodes, keys and values longer than the SSO buffer) must come from the buffer; the upstream
+        // null_memory_resource throws if anything escapes.
+        std::array<std::byte, 4096>         storage {};
+        std::pmr::monotonic_buffer_resource arena {storage.data(), storage.size(), std::pmr::null_memory_resource()};
+
+        auto kvmap = siddiqsoft::string2map::parse<string, std::pmr::string, std::pmr::map<std::pmr::string, std::pmr::string>>(
+                sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s, &arena);
+        ASSERT_EQ(2, kvmap.size());
+        EXPECT_EQ("0123456789abcdef0123456789", kvmap.at("X-Request-Identifier"));
+        EXPECT_EQ("en-US,en;q=0.9,fr;q=0.8", kvmap.at("Accept-Language"));
+        for (const auto& [key, value] : kvmap)
+        {
+            EXPECT_EQ(&arena, key.get_allocator().resource());
+            EXPECT_EQ(&arena, value.get_allocator().resource());
+        }
+    }
+
+    TEST(string2map, pmr_string_to_wstring_unorderedmap)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        std::array<std::byte, 8192>         storage {};
+        std::pmr::monotonic_buffer_resource arena {storage.data(), storage.size(), std::pmr::null_memory_resource()};
+
+        auto kvmap =
+                siddiqsoft::string2map::parse<string, std::pmr::wstring, std::pmr::unordered_map<std::pmr::wstring, std::pmr::wstring>>(
+                        sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s, &arena);
+        ASSERT_EQ(2, kvmap.size());
+        EXPECT_EQ(L"application/x-www-form-urlencoded", kvmap.at(L"Content-Type"));
+        EXPECT_EQ(L"8", kvmap.at(L"Content-Length"));
+    }
+
+    namespace
+    {
+        /// Minimal stateful allocator which counts the allocations made through it.
+        template <typename V> struct counting_allocator
+        {
+            using value_type = V;
+
+            size_t* count {};
+
+            explicit counting_allocator(size_t* c) noexcept
+                : count(c)
+            {
+            }
+
+            template <typename U>
+            counting_allocator(const counting_allocator<U>& other) noexcept
+                : count(other.count)
+            {
+            }
+
+            V* allocate(size_t n)
+            {
+                ++*count;
+                return std::allocator<V> {}.allocate(n);
+            }
+
+            void deallocate(V* p, size_t n) noexcept { std::allocator<V> {}.deallocate(p, n); }
+
+            template <typename U> bool operator==(const counting_allocator<U>& other) const noexcept { return count == other.count; }
+        };
+    } // namespace
+
+    TEST(string2map, custom_allocator_multimap_and_stream)
+    {
+        using namespace std;
+        using cstring   = basic_string<char, char_traits<char>, counting_allocator<char>>;
+        using cmultimap = multimap<cstring, cstring, less<>, counting_allocator<pair<const cstring, cstring>>>;
+
+        std::string sampleStr = "Host: Duplicate-host-name-value\r\nHost: Another-host-name-value\r\n\r\nmy: body"s;
+
+        size_t allocations = 0;
+        auto   kvmap       = siddiqsoft::string2map::parse<string, cstring, cmultimap>(
+                sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s, counting_allocator<pair<const cstring, cstring>> {&allocations});
+        ASSERT_EQ(2, kvmap.size());
+        EXPECT_EQ(2, kvmap.count("Host"));
+        // Two nodes and two long values, all through the container's allocator
+        EXPECT_GE(allocations, 4);
+
+        size_t streamAllocations = 0;
+        siddiqsoft::string2map::stream_parser<string, cstring, cmultimap> parser {
+                ": "s, "\r\n"s, "\r\n\r\n"s, counting_allocator<pair<const cstring, cstring>> {&streamAllocations}};
+        parser.feed(sampleStr);
+        ASSERT_TRUE(parser.terminated());
+        EXPECT_EQ(kvmap, parser.result());
+        EXPECT_EQ(allocations, streamAllocations);
+    }
+
+    TEST(string2map, parse_into_reuses_container)
+    {
+        using namespace std;
+
+        std::unordered_map<string, string> kvmap {};
+        kvmap.reserve(64);
+        const auto buckets = kvmap.bucket_count();
+
+        auto inserted = siddiqsoft::string2map::parse_into(
+                kvmap, "Host: first.example.com\r\nAccept: text/html,application/xhtml+xml\r\n\r\nbody"s, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(2, inserted);
+        EXPECT_EQ("text/html,application/xhtml+xml", kvmap.at("Accept"));
+
+        // The second request replaces the contents; the duplicate key is rejected and its node released.
+        size_t consumed {};
+        inserted = siddiqsoft::string2map::parse_into(kvmap, "Host: second\r\nHost: duplicate\r\n\r\nbody"s, ": "s, "\r\n"s, "\r\n\r\n"s, consumed);
+        EXPECT_EQ(1, inserted);
+        EXPECT_EQ(1, kvmap.size());
+        EXPECT_EQ("second", kvmap.at("Host"));
+        EXPECT_EQ(33, consumed);
+        EXPECT_EQ(buckets, kvmap.bucket_count());
+
+        inserted = siddiqsoft::string2map::parse_into(kvmap, ""s, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(0, inserted);
+        EXPECT_TRUE(kvmap.empty());
+    }
+
+    TEST(string2map, parse_into_keeps_string_capacity)
+    {
+        using namespace std;
+
+        const std::string longValue(200, 'v');
+        std::map<string, string> kvmap {};
+        siddiqsoft::string2map::parse_into(kvmap, "a=" + longValue, "="s, "&"s);
+        ASSERT_EQ(longValue, kvmap.at("a"));
+        const auto* storage = kvmap.at("a").data();
+
+        // A shorter value is assigned into the recycled node and keeps the existing buffer.
+        siddiqsoft::string2map::parse_into(kvmap, "b=short"s, "="s, "&"s);
+        ASSERT_EQ(1, kvmap.size());
+        EXPECT_EQ("short", kvmap.at("b"));
+        EXPECT_EQ(storage, kvmap.at("b").data());
+    }
+
+    TEST(string2map, parse_into_matches_parse)
+    {
+        using namespace std;
+
+        const std::vector<std::string> samples {"Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s,
+                                                "tag=networking&order=newest&final=section"s,
+                                                "A: 1\r\nB: 2\r\nC: 3\r\nD: 4\r\nE: 5\r\n\r\n"s,
+                                                "x: y"s};
+
+        std::multimap<string, string>      multi {};
+        std::map<wstring, wstring>         wide {};
+        std::unordered_map<string, string> hashed {};
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (const auto& sample : samples)
+            {
+                const auto inserted = siddiqsoft::string2map::parse_into(multi, sample, ": "s, "\r\n"s, "\r\n\r\n"s);
+                EXPECT_EQ(inserted, multi.size());
+                EXPECT_EQ((siddiqsoft::string2map::parse<string, string, multimap<string, string>>(sample, ": "s, "\r\n"s, "\r\n\r\n"s)),
+                          multi);
+
+                siddiqsoft::string2map::parse_into(wide, sample, ": "s, "\r\n"s, "\r\n\r\n"s);
+                EXPECT_EQ((siddiqsoft::string2map::parse<string, wstring, map<wstring, wstring>>(sample, ": "s, "\r\n"s, "\r\n\r\n"s)),
+                          wide);
+
+                siddiqsoft::string2map::parse_into(hashed, sample, "="s, "&"s);
+                EXPECT_EQ((siddiqsoft::string2map::parse<string, string, unordered_map<string, string>>(sample, "="s, "&"s)), hashed);
+            }
+        }
+    }
+
+    TEST(string2map, case_insensitive_std_containers)
+    {
+        using namespace std;
+
+        std::string sampleStr = "Content-Length: 8\r\nHOST: www.example.com\r\ncontent-length: 9\r\n\r\nmy: body"s;
+
+        // Keys differing only in case are the same entry (the first wins, as with any duplicate)
+        auto ordered = siddiqsoft::string2map::parse<string, string, map<string, string, ci_less>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        ASSERT_EQ(2, ordered.size());
+        EXPECT_EQ("8", ordered.at("content-length"));
+        EXPECT_EQ("www.example.com", ordered.find("Host"sv)->second);
+
+        auto multi = siddiqsoft::string2map::parse<string, string, multimap<string, string, ci_less>>(sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(2, multi.count("CONTENT-LENGTH"sv));
+
+        auto hashed = siddiqsoft::string2map::parse<string, wstring, unordered_map<wstring, wstring, ci_hash, ci_equal>>(
+                sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s);
+        ASSERT_EQ(2, hashed.size());
+        EXPECT_EQ(L"8", hashed.at(L"CONTENT-LENGTH"));
+        EXPECT_NE(hashed.end(), hashed.find(L"host"sv));
+
+        EXPECT_EQ(ci_hash {}("Content-Type"), ci_hash {}("content-type"s));
+        EXPECT_TRUE(ci_equal {}("Accept"sv, "ACCEPT"));
+        EXPECT_FALSE(ci_equal {}("Accept"sv, "Accept-Language"));
+        EXPECT_TRUE(ci_less {}("accept", "Content-Length"sv));
+        EXPECT_FALSE(ci_less {}("ACCEPT"sv, "accept"));
+    }
+
+    TEST(string2map, cross_type_one_allocation_per_field)
+    {
+        using namespace std;
+        using wcstring = basic_string<wchar_t, char_traits<wchar_t>, counting_allocator<wchar_t>>;
+        using wcmap    = map<wcstring, wcstring, less<>, counting_allocator<pair<const wcstring, wcstring>>>;
+
+        // Keys and values longer than any small-string buffer and containing non-ASCII text.
+        std::string sampleStr = "X-Request-Identifier-\xc3\xa9: 0123456789abcdef\xe2\x82\xac" "0123456789\r\n"
+                                "Accept-Language-Header: en-US,en;q=0.9,fr;q=0.8\r\n\r\nbody"s;
+
+        size_t allocations = 0;
+        auto   kvmap       = siddiqsoft::string2map::parse<string, wcstring, wcmap>(
+                sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s, counting_allocator<pair<const wcstring, wcstring>> {&allocations});
+        ASSERT_EQ(2, kvmap.size());
+        EXPECT_EQ(L"0123456789abcdef\u20ac" L"0123456789", kvmap.find(L"X-Request-Identifier-\u00e9"sv)->second);
+        // One node plus one allocation for each key and each value
+        EXPECT_EQ(2 * 3, allocations);
+    }
+
+    TEST(string2map, reserves_from_delimiter_count)
+    {
+        using namespace std;
+
+        // The vector is sized exactly when the last pair has no value delimiter
+        auto pairs = siddiqsoft::string2map::parse_view("a=1&b=2&c=3"sv, "="sv, "&"sv);
+        EXPECT_EQ(3, pairs.size());
+        EXPECT_EQ(3, pairs.capacity());
+
+        // The count stops at the terminal delimiter: a long body after it does not size the container
+        const std::string withBody = "a=1&b=2&&" + std::string(1 << 20, '&');
+        auto              headers  = siddiqsoft::string2map::parse_view(std::string_view {withBody}, "="sv, "&"sv, "&&"sv);
+        EXPECT_EQ(2, headers.size());
+        EXPECT_LE(headers.capacity(), 8);
+
+        // A header block longer than the counted prefix is estimated from its density (a regrowth would double it)
+        std::string block {};
+        for (int i = 100; i < 400; ++i)
+            block += "Key-" + std::to_string(i) + ": value-" + std::to_string(i) + "\r\n";
+        block += "\r\nbody";
+        auto longHeaders = siddiqsoft::string2map::parse_view(std::string_view {block}, ": "sv, "\r\n"sv, "\r\n\r\n"sv);
+        ASSERT_EQ(300, longHeaders.size());
+        EXPECT_LE(longHeaders.capacity(), 300 + 300 / 4);
+
+        // As is a source without a terminal delimiter which is not a multiple of the prefix in length
+        std::string query {};
+        for (int i = 1000; i < 1700; ++i)
+            query += "k" + std::to_string(i) + "=v&";
+        auto longQuery = siddiqsoft::string2map::parse_view(std::string_view {query}, "="sv, "&"sv);
+        ASSERT_EQ(700, longQuery.size());
+        EXPECT_GE(longQuery.capacity(), 700);
+        EXPECT_LE(longQuery.capacity(), 700 + 700 / 4);
+
+        // Node based containers are not reserved; the results are unchanged
+        std::string sampleStr {};
+        for (int i = 0; i < 200; ++i)
+            sampleStr += "k" + std::to_string(i) + "=" + std::to_string(i) + "&";
+        sampleStr += "&tail=1";
+
+        auto fixed = siddiqsoft::string2map::parse<"=", "&", "&&", string, string, unordered_map<string, string>>(sampleStr);
+        EXPECT_EQ(200, fixed.size());
+        EXPECT_FALSE(fixed.contains("tail"));
+
+        auto flat = siddiqsoft::string2map::parse<string, string, flat_header_map<char>>(sampleStr, "="s, "&"s, "&&"s);
+        EXPECT_EQ(200, flat.size());
+        EXPECT_EQ("199"sv, flat.at("k199"));
+    }
+
+    TEST(string2map, find_value_single_key)
+    {
+        using namespace std;
+
+        const std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\nEmpty: \r\n\r\nmy: body"s;
+        const string_view src {sampleStr};
+
+        EXPECT_EQ("Duplicate"sv, siddiqsoft::string2map::find_value<string_view>(src, "Host", ": ", "\r\n", "\r\n\r\n"));
+        EXPECT_EQ("8"sv, siddiqsoft::string2map::find_value<string_view>(src, "Content-Length", ": ", "\r\n", "\r\n\r\n"));
+        EXPECT_EQ(""sv, siddiqsoft::string2map::find_value<string_view>(src, "Empty", ": ", "\r\n", "\r\n\r\n"));
+        // Beyond the terminal delimiter or absent
+        EXPECT_FALSE(siddiqsoft::string2map::find_value<string_view>(src, "my", ": ", "\r\n", "\r\n\r\n").has_value());
+        EXPECT_FALSE(siddiqsoft::string2map::find_value<string_view>(src, "content-length", ": ", "\r\n", "\r\n\r\n").has_value());
+
+        auto ci = siddiqsoft::string2map::find_value<string_view, case_insensitive>(src, "content-length", ": ", "\r\n", "\r\n\r\n");
+        EXPECT_EQ("8"sv, ci);
+
+        // The view refers to the source
+        auto host = siddiqsoft::string2map::find_value<string_view>(src, "Accept", ": ", "\r\n", "\r\n\r\n");
+        ASSERT_TRUE(host.has_value());
+        EXPECT_EQ(sampleStr.data() + sampleStr.find("Something"), host->data());
+
+        EXPECT_EQ(L"newest"sv, siddiqsoft::string2map::find_value<wstring_view>(L"tag=networking&order=newest&final=section", L"order", L"=", L"&"));
+    }
+
+    TEST(string2map, find_value_stops_early)
+    {
+        using namespace std;
+
+        // Everything after the matching element is garbage that parse would stop on; find_value never looks at it.
+        const std::string sampleStr = "a=1&wanted=yes&=broken"s;
+        EXPECT_EQ("yes"sv, siddiqsoft::string2map::find_value<string_view>(sampleStr, "wanted", "=", "&"));
+
+        // The callback controls the scan: consumed ends after the last element delivered.
+        size_t calls    = 0;
+        size_t consumed = siddiqsoft::string2map::internal_helpers::scan_pairs<char>(
+                "a=1&b=2&c=3"sv, "="sv, "&"sv, ""sv, [&](string_view, string_view) { return ++calls < 2; });
+        EXPECT_EQ(2, calls);
+        EXPECT_EQ(8, consumed);
+    }
+
+    TEST(string2map, find_values_multiple_keys)
+    {
+        using namespace std;
+
+        const std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        const std::array<string_view, 4> wanted {"Content-Length"sv, "Host"sv, "Missing"sv, "my"sv};
+        auto values = siddiqsoft::string2map::find_values<string_view>(sampleStr, wanted, ": ", "\r\n", "\r\n\r\n");
+        EXPECT_EQ("8"sv, values[0]);
+        EXPECT_EQ("Duplicate"sv, values[1]);
+        EXPECT_FALSE(values[2].has_value());
+        EXPECT_FALSE(values[3].has_value());
+
+        const std::array<string_view, 2> headers {"accept"sv, "HOST"sv};
+        auto ci = siddiqsoft::string2map::find_values<string_view, 2, case_insensitive>(sampleStr, headers, ": ", "\r\n", "\r\n\r\n");
+        EXPECT_EQ("Something"sv, ci[0]);
+        EXPECT_EQ("Duplicate"sv, ci[1]);
+
+        // Found before the malformed tail
+        const std::array<string_view, 2> query {"b"sv, "a"sv};
+        auto found = siddiqsoft::string2map::find_values<string_view>("a=1&b=2&=broken"sv, query, "="sv, "&"sv);
+        EXPECT_EQ("2"sv, found[0]);
+        EXPECT_EQ("1"sv, found[1]);
+    }
+
+    TEST(string2map, for_each_pair_source_order)
+    {
+        using namespace std;
+
+        const std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nEmpty: \r\n\r\nmy: body"s;
+
+        vector<pair<string_view, string_view>> seen {};
+        size_t consumed = siddiqsoft::string2map::for_each_pair(
+                sampleStr, ": "s, "\r\n"s, "\r\n\r\n"s, [&](string_view k, string_view v) { seen.emplace_back(k, v); });
+
+        ASSERT_EQ(4, seen.size());
+        EXPECT_EQ(make_pair("Host"sv, "Duplicate"sv), seen[0]);
+        EXPECT_EQ(make_pair("Host"sv, "Hi"sv), seen[1]);
+        EXPECT_EQ(make_pair("Accept"sv, "Something"sv), seen[2]);
+        EXPECT_EQ(make_pair("Empty"sv, ""sv), seen[3]);
+        EXPECT_EQ(sampleStr.find("my: body"), consumed);
+        // The views refer to the source
+        EXPECT_EQ(sampleStr.data(), seen[0].first.data());
+
+        // Without a terminal delimiter the final element needs no trailing value delimiter
+        vector<pair<wstring_view, wstring_view>> query {};
+        consumed = siddiqsoft::string2map::for_each_pair(L"tag=networking&order=newest"sv, L"="sv, L"&"sv, [&](wstring_view k, wstring_view v) {
+            query.emplace_back(k, v);
+        });
+        ASSERT_EQ(2, query.size());
+        EXPECT_EQ(make_pair(L"order"sv, L"newest"sv), query[1]);
+        EXPECT_EQ(27, consumed);
+    }
+
+    TEST(string2map, for_each_pair_stop_signal)
+    {
+        using namespace std;
+
+        size_t calls    = 0;
+        size_t consumed = siddiqsoft::string2map::for_each_pair("a=1&b=2&c=3&=broken"sv, "="sv, "&"sv, [&](string_view, string_view) {
+            return ++calls < 2;
+        });
+        EXPECT_EQ(2, calls);
+        EXPECT_EQ(8, consumed);
+
+        // Compile-time delimiters behave the same
+        calls    = 0;
+        consumed = siddiqsoft::string2map::for_each_pair<"=", "&">("a=1&b=2&c=3&=broken"sv, [&](string_view k, string_view) {
+            ++calls;
+            return k != "b"sv;
+        });
+        EXPECT_EQ(2, calls);
+        EXPECT_EQ(8, consumed);
+    }
+
+    TEST(string2map, for_each_pair_matches_parse)
+    {
+        using namespace std;
+
+        const std::string sampleStr = "Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+
+        multimap<string, string> visited {};
+        size_t                   visitedConsumed = siddiqsoft::string2map::for_each_pair<": ", "\r\n", "\r\n\r\n">(
+                sampleStr, [&](string_view k, string_view v) { visited.emplace(k, v); });
+
+        size_t parsedConsumed = 0;
+        auto   parsed = siddiqsoft::string2map::parse<string, string, multimap<string, string>>(sampleStr, ": ", "\r\n", "\r\n\r\n", parsedConsumed);
+        EXPECT_EQ(parsed, visited);
+        EXPECT_EQ(parsedConsumed, visitedConsumed);
+
+        const std::wstring wideStr = L"k1=v1;k2=v2;;k3=v3"s;
+        size_t             count   = 0;
+        size_t             wideConsumed =
+                siddiqsoft::string2map::for_each_pair(wideStr, L"="s, L";"s, L";;"s, [&](wstring_view, wstring_view) { ++count; });
+        EXPECT_EQ(2, count);
+        EXPECT_EQ(wideStr.find(L"k3"), wideConsumed);
+    }
+
+    TEST(string2map, query_decodes_during_scan)
+    {
+        using namespace std;
+
+        const std::string query = "tag=networking&q=caf%C3%A9+au+lait&path=%2Fa%2fb&odd=100%+%zz%4&a%3Db=c%26d"s;
+
+        size_t consumed = 0;
+        auto   parsed   = siddiqsoft::string2map::parse_query(query, consumed);
+        EXPECT_EQ(query.size(), consumed);
+        EXPECT_EQ(5, parsed.size());
+        EXPECT_EQ("networking", parsed.at("tag"));
+        EXPECT_EQ("caf\u00e9 au lait", parsed.at("q"));
+        EXPECT_EQ("/a/b", parsed.at("path"));
+        // Malformed escapes are kept as is
+        EXPECT_EQ("100% %zz%4", parsed.at("odd"));
+        // Encoded delimiters are decoded after the split
+        EXPECT_EQ("c&d", parsed.at("a=b"));
+
+        // Same parse semantics as parse: duplicates, the empty key stop
+        auto multi = siddiqsoft::string2map::parse_query<string, string, multimap<string, string>>("k=1&k=%32&=x&k=3"s, consumed);
+        EXPECT_EQ((multimap<string, string> {{"k", "1"}, {"k", "2"}}), multi);
+        EXPECT_EQ(10, consumed);
+
+        // Transcoding and wide sources: the escaped bytes are UTF-8
+        auto wide = siddiqsoft::string2map::parse_query<string, wstring>(query);
+        EXPECT_EQ(L"caf\u00e9 au lait", wide.at(L"q"));
+        auto fromWide = siddiqsoft::string2map::parse_query(L"q=caf%C3%A9+%E2%82%AC&p=%zz+1"s);
+        EXPECT_EQ(L"caf\u00e9 \u20ac", fromWide.at(L"q"));
+        EXPECT_EQ(L"%zz 1", fromWide.at(L"p"));
+        auto narrowFromWide = siddiqsoft::string2map::parse_query<wstring, string>(L"q=%E2%82%AC"s);
+        EXPECT_EQ("\u20ac", narrowFromWide.at("q"));
+
+        auto flat = siddiqsoft::string2map::parse_query<string, string, flat_header_map<char>>(query);
+        EXPECT_EQ("caf\u00e9 au lait", flat.at("q"));
+
+        EXPECT_TRUE(siddiqsoft::string2map::parse_query(""s).empty());
+    }
+
+    TEST(string2map, query_url_decode_avoids_copies)
+    {
+        using namespace std;
+
+        std::string scratch {};
+        const auto  plain = "networking"sv;
+        EXPECT_EQ(plain.data(), siddiqsoft::string2map::url_decode(plain, scratch).data());
+        EXPECT_TRUE(scratch.empty());
+
+        EXPECT_EQ("a b/c"sv, siddiqsoft::string2map::url_decode("a+b%2Fc"sv, scratch));
+        EXPECT_EQ("a b/c"s, scratch);
+
+        // Long runs around escapes exercise the vectorized search
+        const std::string longText(200, 'x');
+        EXPECT_EQ(longText + " " + longText + "%", siddiqsoft::string2map::url_decode(std::string_view {longText + "+" + longText + "%"}, scratch));
+
+        std::wstring wscratch {};
+        EXPECT_EQ(L"\u00e9"sv, siddiqsoft::string2map::url_decode(L"%c3%a9"sv, wscratch));
+        // A wide source decodes each run of escapes like the narrow decode followed by the UTF-8 transcoder, including
+        // four byte sequences, truncated and stray bytes and sequences interrupted by a malformed escape
+        for (auto encoded : {"%F0%9F%98%80"sv, "a%C3%A9%E2%82%AC%F0%9F%98%80b"sv, "%E2%82x"sv, "%80%C3"sv, "%ED%A0%80"sv, "%C3%zz%A9"sv})
+        {
+            std::string narrow {};
+            const auto  expected = siddiqsoft::utf::to_wide(siddiqsoft::string2map::url_decode(encoded, narrow));
+            const auto  wide     = siddiqsoft::utf::to_wide(encoded);
+            EXPECT_EQ(expected, siddiqsoft::string2map::url_decode(std::wstring_view {wide}, wscratch)) << encoded;
+        }
+
+        std::vector<std::pair<std::string, std::string>> pairs {};
+        const std::string                                query = "a=1&b%20c=x+y&d=4"s;
+        const auto consumed = siddiqsoft::string2map::for_each_query_pair(query, [&](string_view key, string_view value) {
+            // Components without escapes refer to the source
+            if (key == "a")
+            {
+                EXPECT_EQ(query.data(), key.data());
+            }
+            pairs.emplace_back(key, value);
+            return pairs.size() < 2;
+        });
+        EXPECT_EQ((std::vector<std::pair<std::string, std::string>> {{"a", "1"}, {"b c", "x y"}}), pairs);
+        EXPECT_EQ(query.find("d="), consumed);
+    }
+
+    TEST(string2map, fields_trim_and_unfold)
+    {
+        using namespace std;
+
+        const std::string request = "Host:example.com\r\n"
+                                    "Accept :  text/html \t\r\n"
+                                    "X-Folded: first\r\n"
+                                    "   second\r\n"
+                                    "\tthird \r\n"
+                                    "X-Spaced: a \t\r\n"
+                                    " b  \r\n"
+                                    "\tc\r\n"
+                                    "Empty:\r\n"
+                                    "Trailing-Fold: a\r\n"
+                                    " \r\n"
+                                    "\r\n"
+                                    "Body: not parsed"s;
+
+        size_t consumed = 0;
+        auto   fields   = siddiqsoft::string2map::parse_fields(request, ":"s, "\r\n"s, "\r\n\r\n"s, consumed);
+        EXPECT_EQ(request.find("Body"), consumed);
+        EXPECT_EQ(6, fields.size());
+        EXPECT_EQ("example.com", fields.at("Host"));
+        EXPECT_EQ("text/html", fields.at("Accept"));
+        EXPECT_EQ("first second third", fields.at("X-Folded"));
+        // The whitespace on both sides of a fold is replaced by the single space
+        EXPECT_EQ("a b c", fields.at("X-Spaced"));
+        EXPECT_EQ("", fields.at("Empty"));
+        EXPECT_EQ("a", fields.at("Trailing-Fold"));
+
+        // Without unfolding the continuation lines run into the next key (as with parse)
+        auto trimmed = siddiqsoft::string2map::parse_fields(request, ":"s, "\r\n"s, "\r\n\r\n"s, field_options {true, false});
+        EXPECT_EQ("first", trimmed.at("X-Folded"));
+        EXPECT_FALSE(trimmed.contains("Empty"));
+
+        // Transcoding, flat_header_map and multimap destinations
+        auto wide = siddiqsoft::string2map::parse_fields<string, wstring>(request, ":"s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(L"first second third", wide.at(L"X-Folded"));
+        EXPECT_EQ(L"a b c", wide.at(L"X-Spaced"));
+        auto flat = siddiqsoft::string2map::parse_fields<string, string, flat_header_map<char>>(request, ":"s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ("first second third"sv, flat.at("X-Folded"));
+        EXPECT_EQ("a b c"sv, flat.at("X-Spaced"));
+        EXPECT_EQ("Host" "example.com" "Accept" "text/html" "X-Folded" "first second third" "X-Spaced" "a b c" "Empty" "Trailing-Fold" "a",
+                  flat.arena());
+        EXPECT_EQ("text/html"sv, flat.at("Accept"));
+        auto fromWide = siddiqsoft::string2map::parse_fields<wstring, string, multimap<string, string>>(
+                L"A: 1 \r\nA:\t2\r\n  3\r\n"s, L":"s, L"\r\n"s);
+        EXPECT_EQ((multimap<string, string> {{"A", "1"}, {"A", "2 3"}}), fromWide);
+    }
+
+    TEST(string2map, fields_views_are_sliced)
+    {
+        using namespace std;
+
+        const std::string request = "Host : example.com \r\nX: a\r\n b\r\n\r\n"s;
+
+        std::vector<std::pair<std::string_view, std::string_view>> fields {};
+        const auto consumed = siddiqsoft::string2map::for_each_field(request, ":"s, "\r\n"s, "\r\n\r\n"s, field_options {}, [&](string_view k, string_view v) {
+            fields.emplace_back(k, v);
+        });
+        EXPECT_EQ(request.size(), consumed);
+        ASSERT_EQ(2, fields.size());
+        EXPECT_EQ(make_pair("Host"sv, "example.com"sv), fields[0]);
+        // The views refer to the source; a folded value keeps its line break
+        EXPECT_EQ(request.data() + 7, fields[0].second.data());
+        EXPECT_EQ(make_pair("X"sv, "a\r\n b"sv), fields[1]);
+
+        // Without options the fields match parse_view
+        std::vector<std::pair<std::string_view, std::string_view>> raw {};
+        siddiqsoft::string2map::for_each_field(request, ": "s, "\r\n"s, "\r\n\r\n"s, field_options {false, false}, [&](string_view k, string_view v) {
+            raw.emplace_back(k, v);
+            return raw.size() < 5;
+        });
+        EXPECT_EQ(siddiqsoft::string2map::parse_view("Host : example.com \r\nX: a\r\n b\r\n\r\n"sv, ": "sv, "\r\n"sv, "\r\n\r\n"sv), raw);
+    }
+
+    namespace
+    {
+        /// @brief The compile-time tables of the literal must hold the same pairs as parse into std::map and parse_view.
+        template <delimiter_scan::fixed_string Src,
+                  delimiter_scan::fixed_string KeyDelimiter,
+                  delimiter_scan::fixed_string ValueDelimiter,
+                  delimiter_scan::fixed_string TerminalDelimiter = "">
+        void expect_literal_matches_parse()
+        {
+            using char_t   = internal_helpers::fixed_char_t<Src>;
+            using view_t   = std::basic_string_view<char_t>;
+            using string_t = std::basic_string<char_t>;
+
+            constexpr auto table = parse_literal<Src, KeyDelimiter, ValueDelimiter, TerminalDelimiter>();
+            constexpr auto pairs = parse_literal_view<Src, KeyDelimiter, ValueDelimiter, TerminalDelimiter>();
+
+            const string_t src {delimiter_scan::fixed_view<char_t, Src>()};
+            const string_t keyDelimiter {delimiter_scan::fixed_view<char_t, KeyDelimiter>()};
+            const string_t valueDelimiter {delimiter_scan::fixed_view<char_t, ValueDelimiter>()};
+            const string_t terminalDelimiter {delimiter_scan::fixed_view<char_t, TerminalDelimiter>()};
+
+            EXPECT_EQ((parse<string_t>(src, keyDelimiter, valueDelimiter, terminalDelimiter)),
+                      (std::map<string_t, string_t>(table.begin(), table.end())));
+            EXPECT_EQ((parse_view<view_t>(src, keyDelimiter, valueDelimiter, terminalDelimiter)),
+                      (std::vector<std::pair<view_t, view_t>>(pairs.begin(), pairs.end())));
+        }
+    } // namespace
+
+    TEST(string2map, parse_literal_at_compile_time)
+    {
+        using namespace std;
+
+        constexpr auto headers = siddiqsoft::string2map::parse_literal<"Host: b\r\nAccept: */*\r\nHost: c\r\n\r\nmy: body", ": ", "\r\n", "\r\n\r\n">();
+        static_assert(headers.size() == 2 && headers.capacity() == 2);
+        static_assert(headers.at("Host") == "b");
+        static_assert(headers.begin()->first == "Accept");
+        static_assert(!headers.contains("my"));
+
+        constexpr auto query = siddiqsoft::string2map::parse_literal_view<L"b=2&a=1&b=3", "=", "&">();
+        static_assert(query.size() == 3);
+        static_assert(query[2] == pair {L"b"sv, L"3"sv});
+
+        constexpr auto defaults = siddiqsoft::string2map::parse_literal<8>("retries=3&timeout=30&mode="sv, "=", "&");
+        static_assert(defaults.size() == 3 && defaults.at("mode").empty());
+        static_assert(defaults.begin()->first == "mode");
+        EXPECT_THROW((siddiqsoft::string2map::parse_literal<1>("a=1&b=2"sv, "=", "&")), std::length_error);
+        EXPECT_THROW(defaults.at("missing"), std::out_of_range);
+
+        expect_literal_matches_parse<"", "=", "&">();
+        expect_literal_matches_parse<"a=1&b=2&a=3&&c&=4&d=", "=", "&">();
+        expect_literal_matches_parse<"a=1&b=2&&c=3", "=", "&", "&&">();
+        expect_literal_matches_parse<"Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body",
+                                     ": ",
+                                     "\r\n",
+                                     "\r\n\r\n">();
+        expect_literal_matches_parse<L"x=\u00e9&y=\u20ac&x=2", "=", "&">();
+    }
+
 } // namespace siddiqsoft::string2map
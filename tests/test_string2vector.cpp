@@ -1,4 +1,7 @@
 #include "gtest/gtest.h"
+#include <random>
+#include <ranges>
+#include <string_view>
 #include "../include/siddiqsoft/string2vector.hpp"
 
 
@@ -130,4 +133,120 @@ namespace siddiqsoft::string2vector
         EXPECT_EQ("world", kv[1]);
     }
 
+    // ---- split_view ----
+
+    static_assert(std::ranges::forward_range<split_view<char>>);
+    static_assert(std::ranges::view<split_view<wchar_t>>);
+    static_assert(std::ranges::borrowed_range<split_view<char>>);
+
+    TEST(string2vector, split_view_matches_parse)
+    {
+        using namespace std;
+
+        const std::string delimiters = ",/"s;
+        for (const std::string& src : {""s, ",,,"s, "nodelimiters"s, "a,b,c"s, ",hello,world,"s, "hello,,,world"s, "/a/b/c/d"s, "/,x,/y/,"s})
+        {
+            std::vector<std::string> lazy {};
+            for (auto token : split_view {src, delimiters})
+                lazy.emplace_back(token);
+
+            EXPECT_EQ(siddiqsoft::string2vector::parse<std::string>(src, delimiters), lazy) << src;
+        }
+
+        const std::wstring wideStr = L"Host: Duplicate\r\nHost: Hi\r\nAccept: Something\r\nContent-Length: 8\r\n\r\nmy: body"s;
+        EXPECT_EQ(5, std::ranges::distance(split_view {wideStr, L"\r\n"s}));
+    }
+
+    TEST(string2vector, split_view_refers_to_source)
+    {
+        using namespace std;
+
+        const std::string src = "/a/bb/ccc"s;
+        split_view        segments {src, "/"sv};
+
+        EXPECT_FALSE(segments.empty());
+        EXPECT_EQ("a"sv, segments.front());
+        auto it = segments.begin();
+        EXPECT_EQ(src.data() + 1, (*it).data());
+        EXPECT_EQ(src.data() + 6, (*++++it).data());
+        EXPECT_EQ(std::default_sentinel, ++it);
+
+        EXPECT_TRUE((split_view {"///"sv, "/"sv}.empty()));
+    }
+
+    TEST(string2vector, split_view_composes_with_views)
+    {
+        using namespace std;
+
+        const std::string src = "/api/v1//users/42/"s;
+
+        std::vector<size_t> lengths {};
+        for (auto n : split_view {src, "/"sv} | views::transform([](string_view s) { return s.size(); }))
+            lengths.push_back(n);
+        EXPECT_EQ((std::vector<size_t> {3, 2, 5, 2}), lengths);
+
+        std::vector<string_view> firstTwo {};
+        for (auto s : split_view {src, "/"sv} | views::drop(1) | views::take(2))
+            firstTwo.push_back(s);
+        EXPECT_EQ((std::vector<string_view> {"v1"sv, "users"sv}), firstTwo);
+
+        auto found = std::ranges::find(split_view {src, "/"sv}, "users"sv);
+        ASSERT_NE(std::default_sentinel, found);
+        EXPECT_EQ(src.find("users"), (*found).data() - src.data());
+
+        // Usable in constant expressions
+        static_assert(std::ranges::distance(split_view {"a b  c"sv, " "sv}) == 3);
+    }
+
+    namespace
+    {
+        /// @brief The original find_first_not_of/find_first_of splitter.
+        template <class T> std::vector<T> reference_parse(const T& str, const T& delimiters)
+        {
+            std::vector<T> tokens;
+            auto           lastPos = str.find_first_not_of(delimiters, 0);
+            auto           pos     = str.find_first_of(delimiters, lastPos);
+            while ((T::npos != pos) || (T::npos != lastPos))
+            {
+                tokens.push_back(str.substr(lastPos, pos - lastPos));
+                lastPos = str.find_first_not_of(delimiters, pos);
+                pos     = str.find_first_of(delimiters, lastPos);
+            }
+            return tokens;
+        }
+    } // namespace
+
+    TEST(string2vector, delimiter_set_kernels_match_reference)
+    {
+        using namespace std;
+        using siddiqsoft::delimiter_scan::simd_level;
+
+        std::mt19937                          rng {20240703};
+        std::uniform_int_distribution<size_t> pick(0, 255);
+        const auto                            saved = siddiqsoft::delimiter_scan::active_level();
+
+        for (const std::string& delimiters : {" \t,;"s, "/"s, "\r\n"s, "aeiou \t,;:.!?-_()"s})
+        {
+            std::string  src {};
+            std::wstring wsrc {};
+            for (size_t i = 0; i < 2000; ++i)
+            {
+                const auto value = pick(rng);
+                const char c     = (value % 4 == 0) ? delimiters[value % delimiters.size()] : static_cast<char>(value);
+                src.push_back(c);
+                wsrc.push_back(static_cast<unsigned char>(c));
+            }
+            const std::wstring wdelimiters(delimiters.begin(), delimiters.end());
+
+            for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2})
+            {
+                siddiqsoft::delimiter_scan::set_active_level(level);
+                EXPECT_EQ(reference_parse(src, delimiters), siddiqsoft::string2vector::parse(src, delimiters)) << static_cast<int>(level);
+                EXPECT_EQ(reference_parse(wsrc, wdelimiters), siddiqsoft::string2vector::parse(wsrc, wdelimiters)) << static_cast<int>(level);
+            }
+        }
+
+        siddiqsoft::delimiter_scan::set_active_level(saved);
+    }
+
 } // namespace siddiqsoft::string2vector
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include <clocale>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+#include "../include/siddiqsoft/string2map.hpp"
+#include "../include/siddiqsoft/utf_transcode.hpp"
+
+
+namespace siddiqsoft::utf
+{
+    namespace
+    {
+        /// @brief Reference encoder for a code point sequence (used to build valid UTF-8 and the expected wide string).
+        void append(std::string& narrow, std::wstring& wide, char32_t cp)
+        {
+            char  buffer[4];
+            char* end = internal_helpers::put_utf8(buffer, cp);
+            narrow.append(buffer, end);
+            if constexpr (sizeof(wchar_t) == 2)
+            {
+                if (cp >= 0x10000)
+                {
+                    wide.push_back(static_cast<wchar_t>(0xD800 + ((cp - 0x10000) >> 10)));
+                    wide.push_back(static_cast<wchar_t>(0xDC00 + ((cp - 0x10000) & 0x3FF)));
+                    return;
+                }
+            }
+            wide.push_back(static_cast<wchar_t>(cp));
+        }
+    } // namespace
+
+
+    TEST(utf_transcode, ascii_block_boundaries)
+    {
+        for (size_t length = 0; length < 70; ++length)
+        {
+            std::string  narrow;
+            std::wstring wide;
+            for (size_t i = 0; i < length; ++i)
+                append(narrow, wide, static_cast<char32_t>('!' + (i % 90)));
+
+            EXPECT_EQ(wide, to_wide(narrow)) << length;
+            EXPECT_EQ(narrow, to_utf8(wide)) << length;
+
+            // A non-ASCII element at every position of the run
+            for (size_t at = 0; at < length; at += 5)
+            {
+                std::string  n2 = narrow.substr(0, at);
+                std::wstring w2 = wide.substr(0, at);
+                append(n2, w2, U'\u00e9');
+                n2 += narrow.substr(at);
+                w2 += wide.substr(at);
+                ASSERT_EQ(w2, to_wide(n2)) << length << "@" << at;
+                ASSERT_EQ(n2, to_utf8(w2)) << length << "@" << at;
+            }
+        }
+    }
+
+    TEST(utf_transcode, multibyte_round_trip)
+    {
+        EXPECT_EQ(L"caf\u00e9", to_wide("caf\xc3\xa9"));
+        EXPECT_EQ(L"\u20ac" L"10", to_wide("\xe2\x82\xac" "10"));
+        EXPECT_EQ("\xf0\x9f\x98\x80", to_utf8(L"\U0001F600"));
+        EXPECT_EQ(L"\U0001F600", to_wide("\xf0\x9f\x98\x80"));
+        EXPECT_EQ((sizeof(wchar_t) == 2) ? 2u : 1u, to_wide("\xf0\x9f\x98\x80").size());
+
+        std::mt19937                            rng {20240701};
+        std::uniform_int_distribution<uint32_t> plane(0, 3);
+        for (int round = 0; round < 500; ++round)
+        {
+            std::string  narrow;
+            std::wstring wide;
+            for (int i = 0, len = round % 40; i < len; ++i)
+            {
+                char32_t cp {};
+                switch (plane(rng))
+                {
+                case 0: cp = std::uniform_int_distribution<uint32_t>(0x20, 0x7E)(rng); break;
+                case 1: cp = std::uniform_int_distribution<uint32_t>(0x80, 0x7FF)(rng); break;
+                case 2: cp = std::uniform_int_distribution<uint32_t>(0xE000, 0xFFFD)(rng); break;
+                default: cp = std::uniform_int_distribution<uint32_t>(0x10000, 0x10FFFF)(rng); break;
+                }
+                append(narrow, wide, cp);
+            }
+            ASSERT_EQ(wide, to_wide(narrow)) << round;
+            ASSERT_EQ(narrow, to_utf8(wide)) << round;
+        }
+    }
+
+    TEST(utf_transcode, invalid_utf8_replaced_per_maximal_subpart)
+    {
+        const std::wstring fffd(1, static_cast<wchar_t>(replacement_character));
+
+        // Stray continuation byte and invalid lead bytes
+        EXPECT_EQ(L"a" + fffd + L"b", to_wide("a\x80" "b"));
+        EXPECT_EQ(fffd + fffd, to_wide("\xc0\xaf"));
+        EXPECT_EQ(fffd + L"A", to_wide("\xf5" "A"));
+        // Overlong three byte form: E0 requires A0..BF next
+        EXPECT_EQ(fffd + fffd + fffd, to_wide("\xe0\x80\x80"));
+        // Encoded surrogate
+        EXPECT_EQ(fffd + fffd + fffd, to_wide("\xed\xa0\x80"));
+        // Beyond U+10FFFF
+        EXPECT_EQ(fffd + fffd + fffd + fffd, to_wide("\xf4\x90\x80\x80"));
+        // Truncated sequences are a single maximal subpart
+        EXPECT_EQ(fffd, to_wide("\xf0\x9f\x98"));
+        EXPECT_EQ(fffd + L"x", to_wide("\xe2\x82" "x"));
+        EXPECT_EQ(L"ok" + fffd, to_wide("ok\xc3"));
+    }
+
+    TEST(utf_transcode, invalid_wide_replaced)
+    {
+        // Unpaired surrogates
+        std::wstring lone {L'a', static_cast<wchar_t>(0xD800), L'b', static_cast<wchar_t>(0xDC00)};
+        EXPECT_EQ("a\xef\xbf\xbd" "b\xef\xbf\xbd", to_utf8(lone));
+        if constexpr (sizeof(wchar_t) == 4)
+        {
+            std::wstring outOfRange {static_cast<wchar_t>(0x110000)};
+            EXPECT_EQ("\xef\xbf\xbd", to_utf8(outOfRange));
+        }
+    }
+
+    TEST(utf_transcode, exact_lengths)
+    {
+        std::mt19937                         rng {20240702};
+        static constexpr unsigned char       bytes[] = {'a', 'Z', ' ', 0x80, 0xBF, 0xC3, 0xA9, 0xE2, 0x82, 0xAC, 0xF0, 0x9F, 0x98, 0xED, 0xFF};
+        std::uniform_int_distribution<size_t> pick(0, sizeof(bytes) - 1);
+
+        for (int round = 0; round < 1000; ++round)
+        {
+            // Arbitrary (mostly invalid) UTF-8
+            std::string src;
+            for (int i = 0, len = round % 70; i < len; ++i)
+                src.push_back(static_cast<char>(bytes[pick(rng)]));
+
+            const auto wide = to_wide(src);
+            ASSERT_EQ(wide.size(), wide_length(src)) << round;
+            const auto narrow = to_utf8(wide);
+            ASSERT_EQ(narrow.size(), utf8_length(wide)) << round;
+            // The replacement output is itself valid so it round trips
+            ASSERT_EQ(wide, to_wide(narrow)) << round;
+        }
+
+        // Fresh destinations are allocated once: by the source length for UTF-8 input, exactly for wide input
+        const std::string text(100, 'x');
+        std::wstring      wide;
+        utf8_to_wide(text + "\xe2\x82\xac", wide);
+        EXPECT_EQ(101, wide.size());
+        EXPECT_EQ(103, wide.capacity());
+        std::string narrow;
+        wide_to_utf8(wide, narrow);
+        EXPECT_EQ(103, narrow.size());
+        EXPECT_EQ(103, narrow.capacity());
+    }
+
+    TEST(utf_transcode, parse_is_locale_independent)
+    {
+        using namespace std;
+
+        // The process default "C" locale previously turned non-ASCII text into empty strings.
+        std::setlocale(LC_ALL, "C");
+
+        auto wide = siddiqsoft::string2map::parse<string, wstring, map<wstring, wstring>>(
+                "City: Z\xc3\xbcrich\r\nGreeting: \xe2\x82\xac \xf0\x9f\x98\x80\r\n\r\n"s, ": "s, "\r\n"s, "\r\n\r\n"s);
+        EXPECT_EQ(L"Z\u00fcrich", wide.at(L"City"));
+        EXPECT_EQ(L"\u20ac \U0001F600", wide.at(L"Greeting"));
+
+        auto narrow = siddiqsoft::string2map::parse<wstring, string, map<string, string>>(L"City: Z\u00fcrich\r\n\r\n"s, L": "s, L"\r\n"s, L"\r\n\r\n"s);
+        EXPECT_EQ("Z\xc3\xbcrich", narrow.at("City"));
+
+        // Written directly into allocator-aware destinations
+        std::pmr::wstring target {L"previous contents which are replaced"};
+        utf8_to_wide("\xc3\xa9t\xc3\xa9", target);
+        EXPECT_EQ(L"\u00e9t\u00e9", target);
+    }
+} // namespace siddiqsoft::utf